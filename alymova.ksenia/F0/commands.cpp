@@ -17,10 +17,6 @@ namespace
   {
     return std::find(list.begin(), list.end(), word);
   }
-  bool hasSubword(const std::string& word, const std::string& subword)
-  {
-    return word.find(subword) != std::string::npos;
-  }
   bool hasWord(const WordSet& list, const std::string& word)
   {
     return std::find(list.begin(), list.end(), word) != list.end();
@@ -72,6 +68,22 @@ namespace
     std::set_intersection(list1.begin(), list1.end(), list2.begin(), list2.end(), std::back_inserter(res));
     return res;
   }
+  void indexIfBuilt(SubwordIndex& index, const std::string& name, const std::string& word)
+  {
+    auto it = index.find(name);
+    if (it != index.end())
+    {
+      indexWord(it->second, word);
+    }
+  }
+  void unindexIfBuilt(SubwordIndex& index, const std::string& name, const std::string& word)
+  {
+    auto it = index.find(name);
+    if (it != index.end())
+    {
+      unindexWord(it->second, word);
+    }
+  }
   std::pair< std::string, WordSet > unionListDict(const std::pair< std::string, WordSet >& pair,
     const Dictionary& unioned)
   {
@@ -90,7 +102,7 @@ namespace
   }
 }
 
-void alymova::create(std::istream& in, std::ostream& out, DictSet& set)
+void alymova::create(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index)
 {
   std::string name;
   in >> name;
@@ -105,6 +117,7 @@ void alymova::create(std::istream& in, std::ostream& out, DictSet& set)
   }
   Dictionary dict;
   set.emplace(name, dict);
+  index.erase(name);
   out << "<SUCCESSFULLY CREATED>";
 }
 
@@ -136,7 +149,7 @@ void alymova::size(std::istream& in, std::ostream& out, const DictSet& set)
   out << dict.size();
 }
 
-void alymova::removeDict(std::istream& in, std::ostream& out, DictSet& set)
+void alymova::removeDict(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index)
 {
   std::string name;
   in >> name;
@@ -146,10 +159,11 @@ void alymova::removeDict(std::istream& in, std::ostream& out, DictSet& set)
   }
   set.at(name);
   set.erase(name);
+  index.erase(name);
   out << "<SUCCESSFULLY REMOVED>";
 }
 
-void alymova::addWord(std::istream& in, std::ostream& out, DictSet& set)
+void alymova::addWord(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index)
 {
   std::string name, word, translate;
   in >> name >> word >> translate;
@@ -163,6 +177,7 @@ void alymova::addWord(std::istream& in, std::ostream& out, DictSet& set)
   {
     WordSet translates{translate};
     dict.emplace(word, translates);
+    indexIfBuilt(index, name, word);
     out << "<WORD AND TRANSLATE WERE ADDED>";
     return;
   }
@@ -176,7 +191,7 @@ void alymova::addWord(std::istream& in, std::ostream& out, DictSet& set)
   out << "<WORD AND TRANSLATE ALREADY WERE ADDED>";
 }
 
-void alymova::fixWord(std::istream& in, std::ostream& out, DictSet& set)
+void alymova::fixWord(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index)
 {
   std::string name, word, new_word;
   in >> name >> word >> new_word;
@@ -187,6 +202,8 @@ void alymova::fixWord(std::istream& in, std::ostream& out, DictSet& set)
   Dictionary& dict = set.at(name);
   dict[new_word] = dict.at(word);
   dict.erase(word);
+  indexIfBuilt(index, name, new_word);
+  unindexIfBuilt(index, name, word);
   out << "<SUCCESSFULLY FIXED>";
 }
 
@@ -202,7 +219,7 @@ void alymova::findWord(std::istream& in, std::ostream& out, const DictSet& set)
   out << dict.at(word);
 }
 
-void alymova::containSubword(std::istream& in, std::ostream& out, const DictSet& set)
+void alymova::containSubword(std::istream& in, std::ostream& out, const DictSet& set, SubwordIndex& index)
 {
   std::string name, subword;
   in >> name >> subword;
@@ -211,9 +228,12 @@ void alymova::containSubword(std::istream& in, std::ostream& out, const DictSet&
     throw std::logic_error("<INVALID COMMAND>");
   }
   const Dictionary& dict = set.at(name);
-  WordSet words, suitable;
-  std::transform(dict.begin(), dict.end(), std::back_inserter(words), returnName< WordSet >);
-  std::copy_if(words.begin(), words.end(), std::back_inserter(suitable), std::bind(hasSubword, _1, subword));
+  auto it_index = index.find(name);
+  if (it_index == index.end())
+  {
+    it_index = index.emplace(name, buildTrigramIndex(dict)).first;
+  }
+  WordSet suitable = findSubwords(dict, it_index->second, subword);
   if (suitable.empty())
   {
     out << "<NOT FOUND>";
@@ -222,7 +242,7 @@ void alymova::containSubword(std::istream& in, std::ostream& out, const DictSet&
   out << suitable;
 }
 
-void alymova::removeWord(std::istream& in, std::ostream& out, DictSet& set)
+void alymova::removeWord(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index)
 {
   std::string name, word;
   in >> name >> word;
@@ -233,6 +253,7 @@ void alymova::removeWord(std::istream& in, std::ostream& out, DictSet& set)
   Dictionary& dict = set.at(name);
   dict.at(word);
   dict.erase(word);
+  unindexIfBuilt(index, name, word);
   out << "<SUCCESSFULLY REMOVED>";
 }
 
@@ -347,7 +368,7 @@ void alymova::translate(std::istream& in, std::ostream& out, const DictSet& set)
   out << translates;
 }
 
-void alymova::unionDicts(std::istream& in, std::ostream& out, DictSet& set)
+void alymova::unionDicts(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index)
 {
   std::string newname, name1, name2;
   in >> newname >> name1 >> name2;
@@ -368,10 +389,11 @@ void alymova::unionDicts(std::istream& in, std::ostream& out, DictSet& set)
 
   unioned.insert(difference.begin(), difference.end());
   set[newname] = unioned;
+  index.erase(newname);
   out << "<SUCCESSFULLY INTERSECTED>";
 }
 
-void alymova::intersectDicts(std::istream& in, std::ostream& out, DictSet& set)
+void alymova::intersectDicts(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index)
 {
   std::string newname, name1, name2;
   in >> newname >> name1 >> name2;
@@ -390,6 +412,7 @@ void alymova::intersectDicts(std::istream& in, std::ostream& out, DictSet& set)
   std::transform(tmp.begin(), tmp.end(), d_first, std::bind(intersectListDict, _1, dict2));
 
   set[newname] = intersected;
+  index.erase(newname);
   out << "<SUCCESSFULLY INTERSECTED>";
 }
 
@@ -4,6 +4,7 @@
 #include <functional>
 #include <list>
 #include <map>
+#include "subword-index.hpp"
 
 namespace alymova
 {
@@ -13,22 +14,22 @@ namespace alymova
   using DictSet = std::map< std::string, Dictionary >;
   using ContentDict = std::map< char, std::list< std::string > >;
 
-  void create(std::istream& in, std::ostream& out, DictSet& set);
+  void create(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index);
   void dicts(std::ostream& out, const DictSet& set);
   void size(std::istream& in, std::ostream& out, const DictSet& set);
-  void removeDict(std::istream& in, std::ostream& out, DictSet& set);
-  void addWord(std::istream& in, std::ostream& out, DictSet& set);
-  void fixWord(std::istream& in, std::ostream& out, DictSet& set);
+  void removeDict(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index);
+  void addWord(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index);
+  void fixWord(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index);
   void findWord(std::istream& in, std::ostream& out, const DictSet& set);
-  void containSubword(std::istream& in, std::ostream& out, const DictSet& set);
-  void removeWord(std::istream& in, std::ostream& out, DictSet& set);
+  void containSubword(std::istream& in, std::ostream& out, const DictSet& set, SubwordIndex& index);
+  void removeWord(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index);
   void addTranslate(std::istream& in, std::ostream& out, DictSet& set);
   void findEnglishEquivalent(std::istream& in, std::ostream& out, const DictSet& set);
   void removeTranslate(std::istream& in, std::ostream& out, DictSet& set);
   void printContent(std::istream& in, std::ostream& out, const DictSet& set);
   void translate(std::istream& in, std::ostream& out, const DictSet& set);
-  void unionDicts(std::istream& in, std::ostream& out, DictSet& set);
-  void intersectDicts(std::istream& in, std::ostream& out, DictSet& set);
+  void unionDicts(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index);
+  void intersectDicts(std::istream& in, std::ostream& out, DictSet& set, SubwordIndex& index);
   void printDayWord(std::istream& in, std::ostream& out, const DictSet& set);
 
   void printHelp(std::ostream& out);
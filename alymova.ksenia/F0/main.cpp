@@ -40,6 +40,7 @@ int main(int argc, char** argv)
   try
   {
     DictSet dataset;
+    SubwordIndex index;
     if (argc == 2)
     {
       file >> dataset;
@@ -49,15 +50,21 @@ int main(int argc, char** argv)
       }
     }
     CommandSet commands;
-    commands["create"] = std::bind(create, std::ref(std::cin), std::ref(std::cout), std::ref(dataset));
+    commands["create"] = std::bind(create, std::ref(std::cin), std::ref(std::cout),
+      std::ref(dataset), std::ref(index));
     commands["dictionary_list"] = std::bind(dicts, std::ref(std::cout), std::cref(dataset));
     commands["size"] = std::bind(size, std::ref(std::cin), std::ref(std::cout), std::cref(dataset));
-    commands["remove_dictionary"] = std::bind(removeDict, std::ref(std::cin), std::ref(std::cout), std::ref(dataset));
-    commands["add_word"] = std::bind(addWord, std::ref(std::cin), std::ref(std::cout), std::ref(dataset));
-    commands["fix_word"] = std::bind(fixWord, std::ref(std::cin), std::ref(std::cout), std::ref(dataset));
+    commands["remove_dictionary"] = std::bind(removeDict, std::ref(std::cin), std::ref(std::cout),
+      std::ref(dataset), std::ref(index));
+    commands["add_word"] = std::bind(addWord, std::ref(std::cin), std::ref(std::cout),
+      std::ref(dataset), std::ref(index));
+    commands["fix_word"] = std::bind(fixWord, std::ref(std::cin), std::ref(std::cout),
+      std::ref(dataset), std::ref(index));
     commands["find_word"] = std::bind(findWord, std::ref(std::cin), std::ref(std::cout), std::cref(dataset));
-    commands["contain"] = std::bind(containSubword, std::ref(std::cin), std::ref(std::cout), std::cref(dataset));
-    commands["remove_word"] = std::bind(removeWord, std::ref(std::cin), std::ref(std::cout), std::ref(dataset));
+    commands["contain"] = std::bind(containSubword, std::ref(std::cin), std::ref(std::cout),
+      std::cref(dataset), std::ref(index));
+    commands["remove_word"] = std::bind(removeWord, std::ref(std::cin), std::ref(std::cout),
+      std::ref(dataset), std::ref(index));
     commands["add_translate"] = std::bind(addTranslate, std::ref(std::cin), std::ref(std::cout), std::ref(dataset));
 
     auto short_name1 = std::bind(findEnglishEquivalent, std::ref(std::cin), std::ref(std::cout), std::cref(dataset));
@@ -68,8 +75,10 @@ int main(int argc, char** argv)
 
     commands["print_content"] = std::bind(printContent, std::ref(std::cin), std::ref(std::cout), std::cref(dataset));
     commands["translate"] = std::bind(translate, std::ref(std::cin), std::ref(std::cout), std::cref(dataset));
-    commands["union"] = std::bind(unionDicts, std::ref(std::cin), std::ref(std::cout), std::ref(dataset));
-    commands["intersect"] = std::bind(intersectDicts, std::ref(std::cin), std::ref(std::cout), std::ref(dataset));
+    commands["union"] = std::bind(unionDicts, std::ref(std::cin), std::ref(std::cout),
+      std::ref(dataset), std::ref(index));
+    commands["intersect"] = std::bind(intersectDicts, std::ref(std::cin), std::ref(std::cout),
+      std::ref(dataset), std::ref(index));
     commands["day_word"] = std::bind(printDayWord, std::ref(std::cin), std::ref(std::cout), std::ref(dataset));
 
     std::string command;
@@ -0,0 +1,130 @@
+#include "subword-index.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+  using namespace alymova;
+  using namespace std::placeholders;
+  using Posting = std::set< std::string >;
+  using WordList = std::list< std::string >;
+
+  const size_t trigram_size = 3;
+
+  std::string returnTrigram(const std::string& word, size_t pos)
+  {
+    return word.substr(pos, trigram_size);
+  }
+  std::set< std::string > splitTrigrams(const std::string& word)
+  {
+    std::set< std::string > trigrams;
+    if (word.size() < trigram_size)
+    {
+      return trigrams;
+    }
+    std::vector< size_t > positions(word.size() - trigram_size + 1);
+    std::iota(positions.begin(), positions.end(), 0);
+    auto d_first = std::inserter(trigrams, trigrams.end());
+    std::transform(positions.begin(), positions.end(), d_first, std::bind(returnTrigram, std::cref(word), _1));
+    return trigrams;
+  }
+  void addToPosting(TrigramIndex& index, const std::string& word, const std::string& trigram)
+  {
+    index[trigram].insert(word);
+  }
+  void removeFromPosting(TrigramIndex& index, const std::string& word, const std::string& trigram)
+  {
+    auto it = index.find(trigram);
+    if (it == index.end())
+    {
+      return;
+    }
+    it->second.erase(word);
+    if (it->second.empty())
+    {
+      index.erase(it);
+    }
+  }
+  void indexEntry(TrigramIndex& index, const std::pair< const std::string, WordList >& entry)
+  {
+    indexWord(index, entry.first);
+  }
+  const Posting* findPosting(const TrigramIndex& index, const std::string& trigram)
+  {
+    auto it = index.find(trigram);
+    return it == index.end() ? nullptr : std::addressof(it->second);
+  }
+  bool isMissing(const Posting* posting)
+  {
+    return posting == nullptr;
+  }
+  bool comparePostingSizes(const Posting* posting1, const Posting* posting2)
+  {
+    return posting1->size() < posting2->size();
+  }
+  WordList intersectPosting(const WordList& words, const Posting* posting)
+  {
+    WordList res;
+    std::set_intersection(words.begin(), words.end(), posting->begin(), posting->end(), std::back_inserter(res));
+    return res;
+  }
+  bool hasNoSubword(const std::string& word, const std::string& subword)
+  {
+    return word.find(subword) == std::string::npos;
+  }
+  void collectWithSubword(WordList& res, const std::string& subword,
+    const std::pair< const std::string, WordList >& entry)
+  {
+    if (!hasNoSubword(entry.first, subword))
+    {
+      res.push_back(entry.first);
+    }
+  }
+}
+
+alymova::TrigramIndex alymova::buildTrigramIndex(const Dictionary& dict)
+{
+  TrigramIndex index;
+  std::for_each(dict.begin(), dict.end(), std::bind(indexEntry, std::ref(index), _1));
+  return index;
+}
+
+void alymova::indexWord(TrigramIndex& index, const std::string& word)
+{
+  std::set< std::string > trigrams = splitTrigrams(word);
+  std::for_each(trigrams.begin(), trigrams.end(), std::bind(addToPosting, std::ref(index), std::cref(word), _1));
+}
+
+void alymova::unindexWord(TrigramIndex& index, const std::string& word)
+{
+  std::set< std::string > trigrams = splitTrigrams(word);
+  std::for_each(trigrams.begin(), trigrams.end(), std::bind(removeFromPosting, std::ref(index), std::cref(word), _1));
+}
+
+std::list< std::string > alymova::findSubwords(const Dictionary& dict, const TrigramIndex& index,
+  const std::string& subword)
+{
+  WordList res;
+  if (subword.size() < trigram_size)
+  {
+    std::for_each(dict.begin(), dict.end(), std::bind(collectWithSubword, std::ref(res), std::cref(subword), _1));
+    return res;
+  }
+  std::set< std::string > trigrams = splitTrigrams(subword);
+  std::vector< const Posting* > postings;
+  auto d_first = std::back_inserter(postings);
+  std::transform(trigrams.begin(), trigrams.end(), d_first, std::bind(findPosting, std::cref(index), _1));
+  if (std::any_of(postings.begin(), postings.end(), isMissing))
+  {
+    return res;
+  }
+  std::sort(postings.begin(), postings.end(), comparePostingSizes);
+  res.assign(postings.front()->begin(), postings.front()->end());
+  res = std::accumulate(std::next(postings.begin()), postings.end(), res, intersectPosting);
+  res.remove_if(std::bind(hasNoSubword, _1, std::cref(subword)));
+  return res;
+}
@@ -0,0 +1,20 @@
+#ifndef SUBWORD_INDEX_HPP
+#define SUBWORD_INDEX_HPP
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include "dict-utils.hpp"
+
+namespace alymova
+{
+  using TrigramIndex = std::unordered_map< std::string, std::set< std::string > >;
+  using SubwordIndex = std::map< std::string, TrigramIndex >;
+
+  TrigramIndex buildTrigramIndex(const Dictionary& dict);
+  void indexWord(TrigramIndex& index, const std::string& word);
+  void unindexWord(TrigramIndex& index, const std::string& word);
+  std::list< std::string > findSubwords(const Dictionary& dict, const TrigramIndex& index, const std::string& subword);
+}
+#endif
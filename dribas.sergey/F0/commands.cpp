@@ -5,6 +5,13 @@
 #include <vector>
 #include <functional>
 #include <limits>
+#include <future>
+#include <thread>
+#include <stdexcept>
+#include <sstream>
+#include <iostream>
+#include <dirent.h>
+#include <sys/stat.h>
 #include <delimiter.hpp>
 
 #include "survival.hpp"
@@ -13,38 +20,34 @@
 
 namespace
 {
-  class TimeRangeFilter
-  {
-    time_t start;
-    time_t end;
-  public:
-    TimeRangeFilter(time_t s, time_t e):
-      start(s),
-      end(e)
-    {}
-      bool operator()(const std::pair< time_t, dribas::workout >& session) const
-      {
-        return session.first >= start && session.first <= end;
-      }
-  };
-  struct HeartRateExtractor
+  template< class T >
+  struct ColumnSum
   {
-    int operator()(const std::pair<time_t, dribas:: workout >& session) const
+    const std::vector< T >& column;
+    double operator()(double sum, size_t row) const
     {
-      return session.second.avgHeart;
+      return sum + column[row];
     }
   };
-  struct CadenceExtractor {
-    int operator()(const std::pair< time_t, dribas::workout >& session) const
+
+  template< class T >
+  struct WholeColumnSum
+  {
+    const std::vector< T >& column;
+    double operator()(double sum, size_t row) const
     {
-      return session.second.cadence;
+      long long value = column[row];
+      return sum + value;
     }
   };
-  struct DistanceExtractor
+
+  template< class T >
+  struct ColumnLess
   {
-    double operator()(const std::pair< time_t, dribas::workout >& session) const
+    const std::vector< T >& column;
+    bool operator()(size_t lhs, size_t rhs) const
     {
-      return session.second.distance;
+      return column[lhs] < column[rhs];
     }
   };
 
@@ -74,30 +77,30 @@ namespace
     return static_cast< long long >(hours) * 3600 + static_cast< long long >(minutes) * 60 + static_cast< long long>(seconds);
   }
 
-  double get_workout_numeric_param(const dribas::workout& w, int param_id)
+  double get_workout_numeric_param(const dribas::suite& s, size_t row, int param_id)
   {
     long long value;
     switch (param_id) {
       case 2:
-        value = w.avgHeart;
+        value = s.avg_hearts()[row];
         break;
       case 3:
-        value = w.maxHeart;
+        value = s.max_hearts()[row];
         break;
       case 4:
-        value = w.cadence;
+        value = s.cadences()[row];
         break;
       case 5:
-        value = w.distance;
+        value = s.distances()[row];
         break;
       case 6:
-        value = w.avgPaceMinPerKm;
+        value = s.paces()[row];
         break;
       case 7:
-        value = w.timeStart;
+        value = s.starts()[row];
         break;
       case 8:
-        value = w.timeEnd;
+        value = s.ends()[row];
         break;
       default:
         throw std::runtime_error("unsupported parameter ID: ");
@@ -108,34 +111,88 @@ namespace
   class WorkoutFilter
   {
   private:
+    const dribas::suite& suite_;
     int param_id_;
     std::string op_;
     std::string value_str_;
+    double value_;
     std::string param_name_for_errors_;
   public:
-    WorkoutFilter(int param_id, const std::string& op, const std::string& value_str, const std::string& param_name):
+    WorkoutFilter(const dribas::suite& s, int param_id, const std::string& op, const std::string& value_str,
+      const std::string& param_name):
+      suite_(s),
       param_id_(param_id),
       op_(op),
       value_str_(value_str),
+      value_(param_id == 1 ? 0.0 : std::stod(value_str)),
       param_name_for_errors_(param_name)
     {}
-    bool operator()(const std::pair< const time_t, dribas::workout >& pair) const
+    bool operator()(size_t row) const
     {
-      const dribas::workout& w = pair.second;
       bool match = false;
       if (param_id_ == 1) {
-        match = compareStrings(w.name, op_, value_str_);
+        match = compareStrings(suite_.names()[row], op_, value_str_);
       } else if (param_id_ >= 2 && param_id_ <= 8) {
-        match = compareStrings(get_workout_numeric_param(w, param_id_), op_,std::stod(value_str_));
+        match = compareStrings(get_workout_numeric_param(suite_, row, param_id_), op_, value_);
       } else {
         throw std::runtime_error("Unsupported parameter type for comparison: " + param_name_for_errors_);
       }
       return match;
     }
   };
-  const dribas::workout& get_workout_from_pair(const std::pair< const time_t, dribas::workout >& entry)
+
+  struct FilterMismatch
   {
-    return entry.second;
+    const WorkoutFilter& filter;
+    bool operator()(size_t row) const
+    {
+      return !filter(row);
+    }
+  };
+
+  void filter_by_start_time(const dribas::training_view& source, const std::string& op, const WorkoutFilter& filter,
+    dribas::training_view& filtered)
+  {
+    if (op == ">" || op == ">=") {
+      auto first = std::partition_point(source.begin(), source.end(), FilterMismatch{ filter });
+      filtered.assign(first, source.end());
+    } else if (op == "<" || op == "<=") {
+      auto last = std::partition_point(source.begin(), source.end(), filter);
+      filtered.assign(source.begin(), last);
+    } else {
+      std::copy_if(source.begin(), source.end(), std::back_inserter(filtered), filter);
+    }
+  }
+
+  struct RowToWorkout
+  {
+    const dribas::suite& suite;
+    dribas::workout operator()(size_t row) const
+    {
+      return suite.at(row);
+    }
+  };
+
+  double sum_column(const dribas::suite& s, const dribas::training_view& rows, int param_id)
+  {
+    switch (param_id) {
+      case 2:
+        return std::accumulate(rows.begin(), rows.end(), 0.0, WholeColumnSum< int >{ s.avg_hearts() });
+      case 3:
+        return std::accumulate(rows.begin(), rows.end(), 0.0, WholeColumnSum< int >{ s.max_hearts() });
+      case 4:
+        return std::accumulate(rows.begin(), rows.end(), 0.0, WholeColumnSum< int >{ s.cadences() });
+      case 5:
+        return std::accumulate(rows.begin(), rows.end(), 0.0, WholeColumnSum< double >{ s.distances() });
+      case 6:
+        return std::accumulate(rows.begin(), rows.end(), 0.0, WholeColumnSum< double >{ s.paces() });
+      case 7:
+        return std::accumulate(rows.begin(), rows.end(), 0.0, WholeColumnSum< time_t >{ s.starts() });
+      case 8:
+        return std::accumulate(rows.begin(), rows.end(), 0.0, WholeColumnSum< time_t >{ s.ends() });
+      default:
+        throw std::runtime_error("unsupported parameter ID: ");
+    }
   }
 
   time_t parse_date(int year, int month, int day)
@@ -184,38 +241,130 @@ namespace
     return (it != param_map.end()) ? it->second : 0;
   }
 
-  class GetParamValue
+  class WorkoutComparator
   {
   private:
+    const dribas::suite& suite_;
     int param_id_;
-    std::string param_name_for_errors_;
   public:
-    GetParamValue(int id, const std::string& name):
-      param_id_(id),
-      param_name_for_errors_(name)
+    WorkoutComparator(const dribas::suite& s, int id):
+      suite_(s),
+      param_id_(id)
     {}
-    double operator()(double current_sum, const std::pair< const time_t, dribas::workout >& pair) const
+    bool operator()(size_t a, size_t b) const
     {
-      const dribas::workout& w = pair.second;
-      return current_sum + get_workout_numeric_param(w, param_id_);
+      double val_a = get_workout_numeric_param(suite_, a, param_id_);
+      double val_b = get_workout_numeric_param(suite_, b, param_id_);
+      return val_a > val_b;
     }
   };
 
-  class WorkoutComparator
+  struct GpxFile
   {
-  private:
-    int param_id_;
-  public:
-    WorkoutComparator(int id):
-      param_id_(id)
-    {}
-    bool operator()(const dribas::workout& a, const dribas::workout& b) const
+    std::string name;
+    bool opened;
+    dribas::workout training;
+    std::string errors;
+  };
+
+  struct GpxFileLoader
+  {
+    GpxFile operator()(const std::string& name) const
     {
-      double val_a = get_workout_numeric_param(a, param_id_);
-      double val_b = get_workout_numeric_param(b, param_id_);
-      return val_a > val_b;
+      GpxFile result{ name, false, dribas::workout(), std::string() };
+      std::ifstream file(name);
+      if (!file) {
+        return result;
+      }
+      result.opened = true;
+      std::istream::sentry sentry(file);
+      if (sentry) {
+        file.unsetf(std::ios_base::skipws);
+        std::ostringstream errors;
+        result.training = dribas::parseGpx(file, errors);
+        result.errors = errors.str();
+      }
+      return result;
+    }
+  };
+
+  struct GpxFileReporter
+  {
+    std::ostream& err;
+    std::vector< dribas::workout >& parsed;
+    void operator()(const GpxFile& file) const
+    {
+      if (!file.opened) {
+        err << file.name << ": cannot open file\n";
+        return;
+      }
+      std::istringstream errors(file.errors);
+      std::string line;
+      while (std::getline(errors, line)) {
+        err << file.name << ": " << line << '\n';
+      }
+      parsed.push_back(file.training);
     }
   };
+
+  using FileIterator = std::vector< std::string >::const_iterator;
+
+  std::vector< GpxFile > load_gpx_files(FileIterator first, FileIterator last)
+  {
+    std::vector< GpxFile > trainings;
+    trainings.reserve(std::distance(first, last));
+    std::transform(first, last, std::back_inserter(trainings), GpxFileLoader{});
+    return trainings;
+  }
+
+  bool is_gpx_file(const std::string& name)
+  {
+    const std::string extension = ".gpx";
+    return name.size() > extension.size() && name.compare(name.size() - extension.size(), extension.size(), extension) == 0;
+  }
+
+  std::vector< std::string > list_gpx_files(const std::string& directory)
+  {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+      throw std::invalid_argument("invalid directory name");
+    }
+    std::vector< std::string > files;
+    for (dirent* entry = readdir(dir); entry; entry = readdir(dir)) {
+      std::string name = entry->d_name;
+      if (!is_gpx_file(name)) {
+        continue;
+      }
+      std::string path = directory + '/' + name;
+      struct stat info;
+      if (stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+        files.push_back(path);
+      }
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+    return files;
+  }
+
+  std::vector< GpxFile > load_gpx_files_parallel(const std::vector< std::string >& files)
+  {
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t chunks = std::max< size_t >(1, std::min(threads, files.size()));
+    size_t chunk_size = (files.size() + chunks - 1) / chunks;
+    std::vector< std::future< std::vector< GpxFile > > > tasks;
+    for (size_t begin = chunk_size; begin < files.size(); begin += chunk_size) {
+      auto first = files.begin() + begin;
+      auto last = files.begin() + std::min(files.size(), begin + chunk_size);
+      tasks.push_back(std::async(std::launch::async, load_gpx_files, first, last));
+    }
+    std::vector< GpxFile > trainings = load_gpx_files(files.begin(), files.begin() + std::min(files.size(), chunk_size));
+    for (auto it = tasks.begin(); it != tasks.end(); ++it) {
+      std::vector< GpxFile > chunk = it->get();
+      std::move(chunk.begin(), chunk.end(), std::back_inserter(trainings));
+    }
+    return trainings;
+  }
+
 }
 
 
@@ -229,14 +378,31 @@ void dribas::add_training_from_file(std::istream& in, std::ostream& out, suite&
   if (!in && !in.eof()) {
     throw std::invalid_argument("invalid file name");
   }
-  auto& main_suite = trainng.at(1);
-  main_suite.emplace(training.timeStart, training);
+  trainng.add(training);
   out << "Trainings: " << training;
 }
 
+void dribas::add_trainings_from_dir(std::istream& in, std::ostream& out, suite& trainng)
+{
+  std::string directory;
+  in >> directory;
+  if (!in) {
+    throw std::invalid_argument("invalid directory name");
+  }
+  std::vector< std::string > files = list_gpx_files(directory);
+  std::vector< GpxFile > loaded = load_gpx_files_parallel(files);
+  std::vector< workout > parsed;
+  parsed.reserve(loaded.size());
+  std::for_each(loaded.begin(), loaded.end(), GpxFileReporter{ std::cerr, parsed });
+  std::vector< workout > trainings = trainng.add(parsed);
+  out << "Trainings: " << trainings.size() << '\n';
+  std::copy(trainings.begin(), trainings.end(), std::ostream_iterator< workout >(out, "\n"));
+}
+
 void dribas::show_all_trainings(std::ostream& out, const suite& trainings)
 {
-  std::transform(trainings.at(1).begin(), trainings.at(1).end(), std::ostream_iterator< workout >(out), get_workout_from_pair);
+  const training_view& main_view = trainings.view(1);
+  std::transform(main_view.begin(), main_view.end(), std::ostream_iterator< workout >(out), RowToWorkout{ trainings });
 }
 
 void dribas::show_trainings_by_date(std::istream& in, std::ostream& out, const suite& trainings)
@@ -261,12 +427,13 @@ void dribas::show_trainings_by_date(std::istream& in, std::ostream& out, const s
       out << "Error: start date is after end date\n";
       return;
     }
-    auto lower = trainings.at(1).lower_bound(start_date);
-    auto upper = trainings.at(1).upper_bound(end_date);
+    const training_view& main_view = trainings.view(1);
+    auto lower = trainings.lower_bound(main_view, start_date);
+    auto upper = trainings.upper_bound(main_view, end_date);
     if (lower == upper) {
       out << "No workouts found for specified period.\n";
     } else {
-      std::transform(lower, upper, std::ostream_iterator< workout >(out), get_workout_from_pair);
+      std::transform(lower, upper, std::ostream_iterator< workout >(out), RowToWorkout{ trainings });
       out << "Total found: " << std::distance(lower, upper) << " workouts\n";
     }
   } catch (const std::exception& e) {
@@ -274,7 +441,7 @@ void dribas::show_trainings_by_date(std::istream& in, std::ostream& out, const s
   }
 }
 
-void dribas::query_trainings(std::istream& in, std::ostream& out, std::map< size_t, std::map< time_t, workout > >& trings)
+void dribas::query_trainings(std::istream& in, std::ostream& out, suite& trings)
 {
   std::string param, op, value_str;
   in >> param >> op >> value_str;
@@ -282,24 +449,23 @@ void dribas::query_trainings(std::istream& in, std::ostream& out, std::map< size
   if (param_id == 0) {
     throw std::runtime_error("Invalid parameter: " + param);
   }
-  size_t query_id = 1;
-  if (!trings.empty()) {
-    query_id = trings.rbegin()->first + 1;
-  }
-  std::map< time_t, workout > filtered;
-  auto it_source_workouts = trings.find(1);
-  if (it_source_workouts == trings.end()) {
-    throw std::runtime_error("Source workout list (ID 1) not found.");
+  const training_view& source_workouts = trings.view(1);
+  training_view filtered;
+  if (!source_workouts.empty()) {
+    WorkoutFilter filter_predicate_obj(trings, param_id, op, value_str, param);
+    if (param_id == 7) {
+      filter_by_start_time(source_workouts, op, filter_predicate_obj, filtered);
+    } else {
+      std::copy_if(source_workouts.begin(), source_workouts.end(), std::back_inserter(filtered), filter_predicate_obj);
+    }
   }
-  const auto& source_workouts = it_source_workouts->second;
-  WorkoutFilter filter_predicate_obj(param_id, op, value_str, param);
-  std::copy_if(source_workouts.begin(), source_workouts.end(), std::inserter(filtered, filtered.end()), filter_predicate_obj);
-  trings[query_id] = filtered;
+  size_t found = filtered.size();
+  size_t query_id = trings.add_view(std::move(filtered));
   out << "Query ID: " << query_id << "\n";
-  out << "Found " << filtered.size() << " matching workouts\n";
+  out << "Found " << found << " matching workouts\n";
 }
 
-void dribas::calculate_average(std::istream& in, std::ostream& out, std::map< size_t, std::map< time_t, workout > >& trings)
+void dribas::calculate_average(std::istream& in, std::ostream& out, suite& trings)
 {
   std::string param_name;
   size_t training_id;
@@ -311,36 +477,20 @@ void dribas::calculate_average(std::istream& in, std::ostream& out, std::map< si
   if (param_id == 1) {
     throw std::runtime_error("Cannot calculate average for non-numeric parameter: " + param_name);
   }
-  auto it_workouts_list = trings.find(training_id);
-  if (it_workouts_list == trings.end()) {
+  if (!trings.has_view(training_id)) {
     throw std::runtime_error("Training list with ID " + std::to_string(training_id) + " not found.");
   }
-  const auto& workouts_to_average = it_workouts_list->second;
+  const training_view& workouts_to_average = trings.view(training_id);
   if (workouts_to_average.empty()) {
     out << "No workouts found in list ID " << training_id << " to calculate average.\n";
     return;
   }
-  class GetParamValue {
-  private:
-    int param_id_;
-    std::string param_name_for_errors_;
-  public:
-    GetParamValue(int id, const std::string& name) : param_id_(id), param_name_for_errors_(name) {}
-    double operator()(double current_sum, const std::pair<const time_t, dribas::workout>& pair) const {
-      const dribas::workout& w = pair.second;
-      try {
-        return current_sum + get_workout_numeric_param(w, param_id_);
-      } catch (const std::exception& e) {
-        throw std::runtime_error("Error extracting value for average of parameter '" + param_name_for_errors_ + "': " + e.what());
-      }
-    }
-  };
-  double total_sum = std::accumulate(workouts_to_average.begin(), workouts_to_average.end(), 0.0, GetParamValue(param_id, param_name));
+  double total_sum = sum_column(trings, workouts_to_average, param_id);
   out << "Average " << param_name << " for list ID " << training_id << ": " << total_sum / workouts_to_average.size() << "\n";
 }
 
 
-void dribas::add_training_manual(std::istream& in, std::ostream& out, std::map< size_t, std::map< time_t, workout > >& trainings)
+void dribas::add_training_manual(std::istream& in, std::ostream& out, suite& trainings)
 {
   dribas::workout new_workout;
   unsigned int year, month, day, hour, minute;
@@ -405,9 +555,7 @@ void dribas::add_training_manual(std::istream& in, std::ostream& out, std::map<
     new_workout.avgPaceMinPerKm = 0.0;
   }
 
-  auto& main_suite = trainings[1];
-  auto result = main_suite.emplace(new_workout.timeStart, new_workout);
-  if (!result.second) {
+  if (!trainings.add(new_workout)) {
     out << "Warning: Workout at this start time already exists and was not added.\n";
   } else {
     out << "Workout added successfully.\n";
@@ -434,22 +582,19 @@ void dribas::get_top_trainings(std::istream& in, std::ostream& out, const suite&
   if (param_id == 1) {
     throw std::runtime_error("Cannot get top trainings by string parameter: " + parameter_name);
   }
-  auto it_main_workouts = trainings.find(1);
-  if (it_main_workouts == trainings.end() || it_main_workouts->second.empty()) {
+  const training_view& main_view = trainings.view(1);
+  if (main_view.empty()) {
     out << "No trainings available to find top ones.\n";
     return;
   }
-  std::vector< dribas::workout > all_workouts;
-  auto first = it_main_workouts->second.begin();
-  auto second = it_main_workouts->second.end();
-  std::transform(first, second, std::back_inserter(all_workouts), get_workout_from_pair);
+  training_view all_workouts = main_view;
 
-  WorkoutComparator comparator_obj(param_id);
+  WorkoutComparator comparator_obj(trainings, param_id);
   std::sort(all_workouts.begin(), all_workouts.end(), comparator_obj);
   out << "Top " << n_top << " trainings by " << parameter_name << ":\n";
   auto begin = all_workouts.begin();
   auto end = all_workouts.begin() + std::min(n_top, all_workouts.size());
-  std::copy(begin, end, std::ostream_iterator< dribas::workout >(out, "\n"));
+  std::transform(begin, end, std::ostream_iterator< dribas::workout >(out, "\n"), RowToWorkout{ trainings });
 
   if (n_top > all_workouts.size() && !all_workouts.empty()) {
     out << "Note: Only " << all_workouts.size() << " trainings available, showing all of them.\n";
@@ -475,23 +620,20 @@ void dribas::get_under_trainings(std::istream& in, std::ostream& out, const suit
   if (param_id == 1) {
     throw std::runtime_error("Cannot get under trainings by string parameter: " + parameter_name);
   }
-  auto it_main_workouts = trainings.find(1);
-  if (it_main_workouts == trainings.end() || it_main_workouts->second.empty()) {
+  const training_view& main_view = trainings.view(1);
+  if (main_view.empty()) {
     out << "No trainings available to find top ones.\n";
     return;
   }
-  std::vector< dribas::workout > all_workouts;
-  auto first = it_main_workouts->second.begin();
-  auto second = it_main_workouts->second.end();
-  std::transform(first, second, std::back_inserter(all_workouts), get_workout_from_pair);
+  training_view all_workouts = main_view;
 
-  WorkoutComparator comparator_obj(param_id);
+  WorkoutComparator comparator_obj(trainings, param_id);
   auto cmp = std::bind(comparator_obj, std::placeholders::_2, std::placeholders::_1);
   std::sort(all_workouts.begin(), all_workouts.end(), cmp);
   out << "Top " << n_top << " trainings by " << parameter_name << ":\n";
   auto begin = all_workouts.begin();
   auto end = all_workouts.begin() + std::min(n_top, all_workouts.size());
-  std::copy(begin, end, std::ostream_iterator< dribas::workout >(out, "\n"));
+  std::transform(begin, end, std::ostream_iterator< dribas::workout >(out, "\n"), RowToWorkout{ trainings });
 
   if (n_top > all_workouts.size() && !all_workouts.empty()) {
     out << "Note: Only " << all_workouts.size() << " trainings available, showing all of them.\n";
@@ -500,8 +642,7 @@ void dribas::get_under_trainings(std::istream& in, std::ostream& out, const suit
 
 void dribas::survival_score(std::ostream& out, const suite& suites) {
   try {
-    const auto& main_suite = suites.at(1);
-    out << calculate_survival_score(main_suite);
+    out << calculate_survival_score(suites, suites.view(1));
   } catch (const std::out_of_range&) {
     out << "Error: No workouts found in main suite (id=1)\n";
   } catch (const std::exception& e) {
@@ -518,14 +659,16 @@ void dribas::show_rest(std::istream& in, std::ostream& out, const suite& suites)
   }
   time_t date = parse_date(year, month, day);
   time_t next_day = date + 86400;
-  const auto& main_suite = suites.at(1);
-  auto range_start = main_suite.lower_bound(date);
-  auto range_end = main_suite.lower_bound(next_day);
+  const training_view& main_view = suites.view(1);
+  auto range_start = suites.lower_bound(main_view, date);
+  auto range_end = suites.lower_bound(main_view, next_day);
   if (range_start == range_end) {
     out << "  No workouts found for specified date.\n";
     return;
   }
-  int total_recovery = std::accumulate(range_start, range_end, 0, calculate_workout_recovery);
+  using namespace std::placeholders;
+  auto recovery = std::bind(calculate_workout_recovery, std::cref(suites), _1, _2);
+  int total_recovery = std::accumulate(range_start, range_end, 0, recovery);
 
   StreamGuard guard(out);
   struct tm* date_info = localtime(&date);
@@ -555,7 +698,7 @@ void dribas::show_rest(std::istream& in, std::ostream& out, const suite& suites)
 
 void dribas::predict_result(std::ostream& out, const suite& tren)
 {
-  auto prediction = predict_result(tren.at(1));
+  auto prediction = predict_result(tren, tren.view(1));
   out << prediction << '\n';
 }
 
@@ -569,43 +712,31 @@ void dribas::analyze_training_segment(std::istream& in, std::ostream& out, const
   if (start_time >= end_time) {
     throw std::invalid_argument("Start time must be before end time");
   }
-  auto training_it = trainings.find(training_id);
-  if (training_it == trainings.end()) {
-    throw std::out_of_range("Training not found");
-  }
-  const auto& sessions = training_it->second;
-  std::vector< std::pair< time_t, workout > > filtered_sessions;
-  TimeRangeFilter filter(start_time, end_time);
-  std::copy_if(sessions.begin(), sessions.end(), std::back_inserter(filtered_sessions), filter);
-  if (filtered_sessions.empty()) {
+  const training_view& sessions = trainings.view(training_id);
+  auto first = trainings.lower_bound(sessions, start_time);
+  auto last = trainings.upper_bound(sessions, end_time);
+  if (first == last) {
     throw std::runtime_error("No data found in specified time segment");
   }
-  std::vector< int > heart_rates;
-  HeartRateExtractor hr_extractor;
-  std::transform(filtered_sessions.begin(), filtered_sessions.end(), std::back_inserter(heart_rates), hr_extractor);
-  std::vector< int > cadences;
-  CadenceExtractor cad_extractor;
-  std::transform(filtered_sessions.begin(), filtered_sessions.end(), std::back_inserter(cadences), cad_extractor);
-
-  std::vector< double > distances;
-  DistanceExtractor dist_extractor;
-  std::transform(filtered_sessions.begin(), filtered_sessions.end(), std::back_inserter(distances), dist_extractor);
+  size_t count = std::distance(first, last);
+  const std::vector< int >& heart_rates = trainings.avg_hearts();
+  const std::vector< int >& cadences = trainings.cadences();
 
-  double avg_heart = std::accumulate(heart_rates.begin(), heart_rates.end(), 0.0) / heart_rates.size();
-  double avg_cadence = std::accumulate(cadences.begin(), cadences.end(), 0.0) / cadences.size();
-  double avg_distance = std::accumulate(distances.begin(), distances.end(), 0.0) / distances.size();
+  double avg_heart = std::accumulate(first, last, 0.0, ColumnSum< int >{ heart_rates }) / count;
+  double avg_cadence = std::accumulate(first, last, 0.0, ColumnSum< int >{ cadences }) / count;
+  double avg_distance = std::accumulate(first, last, 0.0, ColumnSum< double >{ trainings.distances() }) / count;
 
-  auto hr_minmax = std::minmax_element(heart_rates.begin(), heart_rates.end());
-  auto cad_minmax = std::minmax_element(cadences.begin(), cadences.end());
+  auto hr_minmax = std::minmax_element(first, last, ColumnLess< int >{ heart_rates });
+  auto cad_minmax = std::minmax_element(first, last, ColumnLess< int >{ cadences });
 
   out << "Training Segment Analysis (ID: " << training_id << ")\n";
   out << "Time range: " << std::asctime(std::localtime(&start_time));
   out << " - " << std::asctime(std::localtime(&end_time));
-  out << "Sessions analyzed: " << filtered_sessions.size() << "\n";
+  out << "Sessions analyzed: " << count << "\n";
   out << "Average Heart Rate: " << std::fixed << std::setprecision(1) << avg_heart << " bpm\n";
-  out << "Min/Max Heart Rate: " << *hr_minmax.first << "/" << *hr_minmax.second << " bpm\n";
+  out << "Min/Max Heart Rate: " << heart_rates[*hr_minmax.first] << "/" << heart_rates[*hr_minmax.second] << " bpm\n";
   out << "Average Cadence: " << std::fixed << std::setprecision(1) << avg_cadence << " rpm\n";
-  out << "Min/Max Cadence: " << *cad_minmax.first << "/" << *cad_minmax.second << " rpm\n";
+  out << "Min/Max Cadence: " << cadences[*cad_minmax.first] << "/" << cadences[*cad_minmax.second] << " rpm\n";
   out << "Average Distance: " << std::fixed << std::setprecision(2) << avg_distance << " km\n";
 }
 void dribas::delete_training_by_key(std::istream& in, std::ostream& out, suite& trainings)
@@ -636,8 +767,7 @@ void dribas::delete_training_by_key(std::istream& in, std::ostream& out, suite&
   if (key_time == static_cast< time_t >(-1)) {
     throw std::runtime_error(".");
   }
-  auto& main_suite = trainings[1];
-  main_suite.erase(key_time);
+  trainings.erase(key_time);
 }
 
 void dribas::delete_training_suite(std::istream& in, std::ostream& out, suite& trainings)
@@ -650,9 +780,8 @@ void dribas::delete_training_suite(std::istream& in, std::ostream& out, suite& t
   if (training_id == 1) {
     throw std::invalid_argument("Cannot delete the main training suite (ID 1)");
   }
-  auto it = trainings.find(training_id);
-  size_t removed_count = it->second.size();
-  trainings.erase(it);
+  size_t removed_count = trainings.view(training_id).size();
+  trainings.erase_view(training_id);
   out << "Deleted training suite ID " << training_id;
   out<< " containing " << removed_count << " workouts\n";
   out << "Note: The workouts still exist in the main training suite (ID 1)\n";
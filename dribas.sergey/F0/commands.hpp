@@ -1,14 +1,16 @@
 #ifndef CMDS_HPP
 #define CMDS_HPP
 
-#include <map>
-#include "workout.hpp"
+#include <istream>
+#include <ostream>
+#include "training_suite.hpp"
 
 namespace dribas
 {
-  using suite = std::map< size_t, std::map< time_t, dribas::workout > >;
+  using suite = training_suite;
   void add_training_manual(std::istream&, std::ostream&, suite&);
   void add_training_from_file(std::istream&, std::ostream&, suite&);
+  void add_trainings_from_dir(std::istream&, std::ostream&, suite&);
   void show_all_trainings(std::ostream&, const suite&);
   void show_trainings_by_date(std::istream&, std::ostream&, const suite&);
   void query_trainings(std::istream&, std::ostream&, suite&);
@@ -10,11 +10,11 @@
 
 int main()
 {
-  std::map< size_t, std::map< time_t, dribas::workout > > suite;
-  suite[1] = std::map< time_t, dribas::workout >();
+  dribas::suite suite;
   std::map< std::string, std::function< void() > > cmds;
   cmds["add_training_manual"] = std::bind(dribas::add_training_manual, std::ref(std::cin), std::ref(std::cout), std::ref(suite));
   cmds["add_training_from_file"] = std::bind(dribas::add_training_from_file, std::ref(std::cin), std::ref(std::cout), std::ref(suite));
+  cmds["add_trainings_from_dir"] = std::bind(dribas::add_trainings_from_dir, std::ref(std::cin), std::ref(std::cout), std::ref(suite));
   cmds["show_all_trainings"] = std::bind(dribas::show_all_trainings, std::ref(std::cout), std::cref(suite));
   cmds["show_trainings_by_date"] = std::bind(dribas::show_trainings_by_date, std::ref(std::cin), std::ref(std::cout), std::cref(suite));
   cmds["query_trainings"] = std::bind(dribas::query_trainings, std::ref(std::cin), std::ref(std::cout), std::ref(suite));
@@ -35,23 +35,29 @@ namespace
       max_distance(0.0),
       min_pace(std::numeric_limits< double >::max())
     {}
-    WorkoutStats operator()(WorkoutStats stats, const std::pair<time_t, dribas::workout>& entry) const
+  };
+
+  struct WorkoutStatsAccumulator
+  {
+    const dribas::training_suite& suite;
+    WorkoutStats operator()(WorkoutStats stats, size_t row) const
     {
-      const auto& w = entry.second;
-      if (w.distance > 0 && w.avgPaceMinPerKm > 0) {
+      double distance = suite.distances()[row];
+      double pace = suite.paces()[row];
+      if (distance > 0 && pace > 0) {
         stats.count++;
-        stats.max_distance = std::max(stats.max_distance, w.distance);
-        stats.min_pace = std::min(stats.min_pace, w.avgPaceMinPerKm);
+        stats.max_distance = std::max(stats.max_distance, distance);
+        stats.min_pace = std::min(stats.min_pace, pace);
       }
       return stats;
     }
   };
 }
 
-dribas::RacePrediction dribas::predict_result(const std::map<time_t, workout>& workouts)
+dribas::RacePrediction dribas::predict_result(const training_suite& suite, const training_view& workouts)
 {
   RacePrediction prediction = { 0.0, 0.0, 0.0, 0.0 };
-  WorkoutStats stats = std::accumulate(workouts.begin(), workouts.end(), WorkoutStats{}, WorkoutStats());
+  WorkoutStats stats = std::accumulate(workouts.begin(), workouts.end(), WorkoutStats{}, WorkoutStatsAccumulator{ suite });
 
   if (stats.count == 0) {
     return prediction;
@@ -3,7 +3,7 @@
 
 #include <map>
 #include <ostream>
-#include "workout.hpp"
+#include "training_suite.hpp"
 
 namespace dribas
 {
@@ -14,7 +14,7 @@ namespace dribas
     double halfMarathon;
     double marathon;
   };
-  RacePrediction predict_result(const std::map< time_t, workout >&);
+  RacePrediction predict_result(const training_suite&, const training_view&);
   std::ostream& operator<<(std::ostream&, const RacePrediction&);
 
 }
@@ -1,17 +1,20 @@
 #include "rest_time.hpp"
 
-int dribas::get_rest_time(const workout& w)
+int dribas::get_rest_time(const training_suite& suite, size_t row)
 {
   double trimp = 0.0;
-  if (w.avgHeart > 0 && w.timeEnd > w.timeStart) {
-    double duration_min = (w.timeEnd - w.timeStart) / 60.0;
-    double heart_rate_ratio = (w.avgHeart - 60.0) / (200.0 - 60.0);
+  int avg_heart = suite.avg_hearts()[row];
+  time_t start = suite.starts()[row];
+  time_t end = suite.ends()[row];
+  if (avg_heart > 0 && end > start) {
+    double duration_min = (end - start) / 60.0;
+    double heart_rate_ratio = (avg_heart - 60.0) / (200.0 - 60.0);
     trimp = duration_min * heart_rate_ratio * std::exp(1.92 * heart_rate_ratio);
   }
   return static_cast< int >(trimp);
 }
 
-int dribas::calculate_workout_recovery(int sum, const std::pair<time_t, workout>& pair)
+int dribas::calculate_workout_recovery(const training_suite& suite, int sum, size_t row)
 {
-  return sum + get_rest_time(pair.second);
+  return sum + get_rest_time(suite, row);
 }
@@ -1,12 +1,12 @@
 #ifndef REST_TIME_HPP
 #define REST_TIME_HPP
 
-#include "workout.hpp"
+#include "training_suite.hpp"
 
 namespace dribas
 {
-  int get_rest_time(const workout&);
-  int calculate_workout_recovery(int sum, const std::pair< time_t, workout >& pair);
+  int get_rest_time(const training_suite&, size_t row);
+  int calculate_workout_recovery(const training_suite&, int sum, size_t row);
 }
 
 #endif
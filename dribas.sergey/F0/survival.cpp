@@ -1,13 +1,13 @@
 #include "survival.hpp"
+#include <functional>
 
 using Accum = dribas::WorkoutAccumulator;
 
-Accum dribas::accumulate_workout_data(Accum acc, const std::pair< time_t, dribas::workout >& entry)
+Accum dribas::accumulate_workout_data(const training_suite& suite, Accum acc, size_t row)
 {
-  const auto& w = entry.second;
-  acc.totalDistance += w.distance;
-  acc.totalDuration += (w.timeEnd - w.timeStart) / 3600.0;
-  acc.strengthSum += (w.maxHeart - w.avgHeart) + w.cadence;
+  acc.totalDistance += suite.distances()[row];
+  acc.totalDuration += (suite.ends()[row] - suite.starts()[row]) / 3600.0;
+  acc.strengthSum += (suite.max_hearts()[row] - suite.avg_hearts()[row]) + suite.cadences()[row];
   acc.workoutCount++;
   return acc;
 }
@@ -21,14 +21,16 @@ std::string dribas::RecommendationGenerator::operator()(const std::pair< double,
   return std::string();
 }
 
-dribas::SurvivalScore dribas::calculate_survival_score(const std::map< time_t, dribas::workout >& workouts)
+dribas::SurvivalScore dribas::calculate_survival_score(const training_suite& suite, const training_view& workouts)
 {
   dribas::SurvivalScore score{};
   if (workouts.empty()) {
     return score;
   }
   auto accum = Accum{};
-  const auto totals = std::accumulate(workouts.begin(), workouts.end(), accum, dribas::accumulate_workout_data);
+  using namespace std::placeholders;
+  auto accumulate_row = std::bind(dribas::accumulate_workout_data, std::cref(suite), _1, _2);
+  const auto totals = std::accumulate(workouts.begin(), workouts.end(), accum, accumulate_row);
   score.enduranceScore = (totals.totalDistance * totals.totalDuration) / totals.workoutCount;
   score.strengthScore = totals.strengthSum / totals.workoutCount;
 
@@ -11,7 +11,7 @@
 #include <string>
 
 #include <streamGuard.hpp>
-#include "workout.hpp"
+#include "training_suite.hpp"
 
 namespace dribas
 {
@@ -35,8 +35,9 @@ namespace dribas
 
   WorkoutAccumulator accumulate_workout_data
   (
+    const training_suite& suite,
     WorkoutAccumulator acc,
-    const std::pair< time_t, workout >& entry);
+    size_t row);
 
   struct RecommendationGenerator
   {
@@ -44,7 +45,7 @@ namespace dribas
     std::string operator()(const std::pair< double, std::string >& rule) const;
   };
 
-  SurvivalScore calculate_survival_score(const std::map< time_t, workout >& workouts);
+  SurvivalScore calculate_survival_score(const training_suite& suite, const training_view& workouts);
 
   std::ostream& operator<<(std::ostream& os, const SurvivalScore& score);
 
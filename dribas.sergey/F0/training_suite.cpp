@@ -0,0 +1,177 @@
+#include "training_suite.hpp"
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+  struct StartBefore
+  {
+    const std::vector< time_t >& starts;
+    bool operator()(size_t row, time_t start) const
+    {
+      return starts[row] < start;
+    }
+    bool operator()(time_t start, size_t row) const
+    {
+      return start < starts[row];
+    }
+  };
+
+  struct RowStartLess
+  {
+    const std::vector< time_t >& starts;
+    bool operator()(size_t lhs, size_t rhs) const
+    {
+      return starts[lhs] < starts[rhs];
+    }
+  };
+}
+
+dribas::training_suite::training_suite()
+{
+  views_[1];
+}
+
+bool dribas::training_suite::add(const workout& w)
+{
+  training_view& main_view = views_[1];
+  auto pos = lower_bound(main_view, w.timeStart);
+  if (pos != main_view.end() && starts_[*pos] == w.timeStart) {
+    return false;
+  }
+  main_view.insert(pos, push_row(w));
+  return true;
+}
+
+std::vector< dribas::workout > dribas::training_suite::add(const std::vector< workout >& batch)
+{
+  training_view& main_view = views_[1];
+  const size_t old_size = main_view.size();
+  std::set< time_t > batch_starts;
+  std::vector< workout > added;
+  for (auto it = batch.begin(); it != batch.end(); ++it) {
+    auto last = main_view.begin() + old_size;
+    auto pos = std::lower_bound(main_view.begin(), last, it->timeStart, StartBefore{ starts_ });
+    if ((pos != last && starts_[*pos] == it->timeStart) || !batch_starts.insert(it->timeStart).second) {
+      continue;
+    }
+    main_view.push_back(push_row(*it));
+    added.push_back(*it);
+  }
+  auto middle = main_view.begin() + old_size;
+  std::sort(middle, main_view.end(), RowStartLess{ starts_ });
+  std::inplace_merge(main_view.begin(), middle, main_view.end(), RowStartLess{ starts_ });
+  return added;
+}
+
+bool dribas::training_suite::erase(time_t start)
+{
+  training_view& main_view = views_[1];
+  auto pos = lower_bound(main_view, start);
+  if (pos == main_view.end() || starts_[*pos] != start) {
+    return false;
+  }
+  main_view.erase(pos);
+  return true;
+}
+
+size_t dribas::training_suite::push_row(const workout& w)
+{
+  names_.push_back(w.name);
+  avg_hearts_.push_back(w.avgHeart);
+  max_hearts_.push_back(w.maxHeart);
+  cadences_.push_back(w.cadence);
+  distances_.push_back(w.distance);
+  paces_.push_back(w.avgPaceMinPerKm);
+  starts_.push_back(w.timeStart);
+  ends_.push_back(w.timeEnd);
+  return starts_.size() - 1;
+}
+
+dribas::workout dribas::training_suite::at(size_t row) const
+{
+  workout w;
+  w.name = names_.at(row);
+  w.avgHeart = avg_hearts_[row];
+  w.maxHeart = max_hearts_[row];
+  w.cadence = cadences_[row];
+  w.distance = distances_[row];
+  w.avgPaceMinPerKm = paces_[row];
+  w.timeStart = starts_[row];
+  w.timeEnd = ends_[row];
+  return w;
+}
+
+bool dribas::training_suite::has_view(size_t id) const
+{
+  return views_.find(id) != views_.end();
+}
+
+const dribas::training_view& dribas::training_suite::view(size_t id) const
+{
+  return views_.at(id);
+}
+
+size_t dribas::training_suite::add_view(training_view rows)
+{
+  size_t id = views_.rbegin()->first + 1;
+  views_[id] = std::move(rows);
+  return id;
+}
+
+bool dribas::training_suite::erase_view(size_t id)
+{
+  return id != 1 && views_.erase(id) != 0;
+}
+
+dribas::training_suite::const_iterator dribas::training_suite::lower_bound(const training_view& rows, time_t start) const
+{
+  return std::lower_bound(rows.begin(), rows.end(), start, StartBefore{ starts_ });
+}
+
+dribas::training_suite::const_iterator dribas::training_suite::upper_bound(const training_view& rows, time_t start) const
+{
+  return std::upper_bound(rows.begin(), rows.end(), start, StartBefore{ starts_ });
+}
+
+const std::vector< std::string >& dribas::training_suite::names() const noexcept
+{
+  return names_;
+}
+
+const std::vector< int >& dribas::training_suite::avg_hearts() const noexcept
+{
+  return avg_hearts_;
+}
+
+const std::vector< int >& dribas::training_suite::max_hearts() const noexcept
+{
+  return max_hearts_;
+}
+
+const std::vector< int >& dribas::training_suite::cadences() const noexcept
+{
+  return cadences_;
+}
+
+const std::vector< double >& dribas::training_suite::distances() const noexcept
+{
+  return distances_;
+}
+
+const std::vector< double >& dribas::training_suite::paces() const noexcept
+{
+  return paces_;
+}
+
+const std::vector< time_t >& dribas::training_suite::starts() const noexcept
+{
+  return starts_;
+}
+
+const std::vector< time_t >& dribas::training_suite::ends() const noexcept
+{
+  return ends_;
+}
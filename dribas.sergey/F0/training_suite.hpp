@@ -0,0 +1,57 @@
+#ifndef TRAINING_SUITE_HPP
+#define TRAINING_SUITE_HPP
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+#include "workout.hpp"
+
+namespace dribas
+{
+  using training_view = std::vector< size_t >;
+
+  class training_suite
+  {
+  public:
+    using const_iterator = training_view::const_iterator;
+
+    training_suite();
+
+    bool add(const workout& w);
+    std::vector< workout > add(const std::vector< workout >& batch);
+    bool erase(time_t start);
+    workout at(size_t row) const;
+
+    bool has_view(size_t id) const;
+    const training_view& view(size_t id) const;
+    size_t add_view(training_view rows);
+    bool erase_view(size_t id);
+
+    const_iterator lower_bound(const training_view& rows, time_t start) const;
+    const_iterator upper_bound(const training_view& rows, time_t start) const;
+
+    const std::vector< std::string >& names() const noexcept;
+    const std::vector< int >& avg_hearts() const noexcept;
+    const std::vector< int >& max_hearts() const noexcept;
+    const std::vector< int >& cadences() const noexcept;
+    const std::vector< double >& distances() const noexcept;
+    const std::vector< double >& paces() const noexcept;
+    const std::vector< time_t >& starts() const noexcept;
+    const std::vector< time_t >& ends() const noexcept;
+  private:
+    std::vector< std::string > names_;
+    std::vector< int > avg_hearts_;
+    std::vector< int > max_hearts_;
+    std::vector< int > cadences_;
+    std::vector< double > distances_;
+    std::vector< double > paces_;
+    std::vector< time_t > starts_;
+    std::vector< time_t > ends_;
+    std::map< size_t, training_view > views_;
+
+    size_t push_row(const workout& w);
+  };
+}
+
+#endif
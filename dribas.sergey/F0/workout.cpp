@@ -2,20 +2,14 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <numeric>
-#include <locale>
 #include <stdexcept>
 #include <cmath>
-#include <numbers>
+#include <cstdlib>
+#include <cctype>
 #include <streamGuard.hpp>
 #include <iomanip>
 
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
-#include <boost/date_time/time_facet.hpp>
-#include <boost/optional.hpp>
-#include <boost/date_time/posix_time/posix_time_io.hpp>
 
 namespace
 {
@@ -38,141 +32,585 @@ namespace
     double distance = kEarthRadiusKm * c;
     return distance;
   }
-}
 
-namespace dribas
-{
-  workout parseGpx(std::istream& gpxStream)
+  bool readDigits(const std::string& str, size_t pos, size_t count, int& value)
   {
-    workout result;
-    boost::property_tree::ptree pt;
-    try {
-      boost::property_tree::read_xml(gpxStream, pt);
-    } catch (const boost::property_tree::xml_parser_error& e) {
-      std::cerr << "XML error: " << e.what() << '\n';
-      return result;
+    if (pos + count > str.size()) {
+      return false;
+    }
+    value = 0;
+    for (size_t i = pos; i < pos + count; ++i) {
+      if (!std::isdigit(static_cast< unsigned char >(str[i]))) {
+        return false;
+      }
+      value = value * 10 + (str[i] - '0');
     }
+    return true;
+  }
 
-    result.name = pt.get< std::string >("gpx.trk.name", "Unknown workout");
+  long long daysFromCivil(int year, int month, int day)
+  {
+    year -= month <= 2;
+    long long era = (year >= 0 ? year : year - 399) / 400;
+    long long yearOfEra = year - era * 400;
+    long long dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+  }
 
-    std::vector< int > heartRates;
-    std::vector< int > cadences;
-    boost::posix_time::ptime startTimePt;
-    boost::posix_time::ptime endTimePt;
-    bool firstPoint = true;
+  bool parseTimestamp(const std::string& str, long long& seconds)
+  {
+    const int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    bool ok = readDigits(str, 0, 4, year) && str[4] == '-' && readDigits(str, 5, 2, month) && str[7] == '-';
+    ok = ok && readDigits(str, 8, 2, day) && str[10] == 'T' && readDigits(str, 11, 2, hour) && str[13] == ':';
+    ok = ok && readDigits(str, 14, 2, minute) && str[16] == ':' && readDigits(str, 17, 2, second);
+    if (!ok || year < 1400 || month < 1 || month > 12 || hour > 23 || minute > 59 || second > 59) {
+      return false;
+    }
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (day < 1 || day > daysInMonth[month - 1] + (month == 2 && leap)) {
+      return false;
+    }
+    seconds = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    return true;
+  }
 
-    double prevLat = 0.0;
-    double prevLon = 0.0;
+  bool parseCoordinate(const std::string& str, double& value)
+  {
+    const char* begin = str.c_str();
+    char* end = nullptr;
+    value = std::strtod(begin, &end);
+    if (end == begin) {
+      return false;
+    }
+    while (std::isspace(static_cast< unsigned char >(*end))) {
+      ++end;
+    }
+    return *end == '\0';
+  }
 
-    try {
-      for (const auto& trkptV : pt.get_child("gpx.trk.trkseg")) {
-        if (trkptV.first == "trkpt") {
-          std::string timeStr = trkptV.second.get< std::string >("time");
-          size_t dotPos = timeStr.find('.');
-          if (dotPos != std::string::npos) {
-            timeStr = timeStr.substr(0, dotPos);
-          }
-          if (!timeStr.empty() && timeStr.back() == 'Z') {
-            timeStr.pop_back();
-          }
-          try {
-            std::stringstream timeSs(timeStr);
-            timeSs.imbue(std::locale(std::locale::classic(), new boost::posix_time::time_input_facet("%Y-%m-%dT%H:%M:%S")));
-            boost::posix_time::ptime currentTimestamp;
-            timeSs >> currentTimestamp;
-            if (timeSs.fail() || currentTimestamp.is_special()) {
-              throw std::runtime_error("Time parse failed: " + timeStr);
-            }
-            if (firstPoint) {
-              startTimePt = currentTimestamp;
-            }
-            endTimePt = currentTimestamp;
-          } catch (const std::exception& e) {
-            std::cerr << "Time error: '" << timeStr << "' - " << e.what() << '\n';
-          }
-
-          double currentLat = 0.0;
-          double currentLon = 0.0;
-
-          try {
-            currentLat = trkptV.second.get< double >("<xmlattr>.lat");
-            currentLon = trkptV.second.get< double >("<xmlattr>.lon");
-          } catch (const boost::bad_lexical_cast& e) {
-            std::cerr << "Coord error: " << e.what() << '\n';
-            firstPoint = true;
-            continue;
-          } catch (const boost::property_tree::ptree_bad_path& e) {
-            std::cerr << "No coords in trkpt: " << e.what() << '\n';
-            firstPoint = true;
-            continue;
-          }
-
-          if (!firstPoint) {
-            result.distance += calculateDistance(prevLat, prevLon, currentLat, currentLon);
-          } else {
-            firstPoint = false;
-          }
-          prevLat = currentLat;
-          prevLon = currentLon;
-
-          boost::optional< std::string >hrStrOpt = trkptV.second.get_optional< std::string >("extensions.ns3:TrackPointExtension.ns3:hr");
-          if (hrStrOpt) {
-            try {
-              int hr = std::stoi(*hrStrOpt);
-              heartRates.push_back(hr);
-            } catch (const std::invalid_argument&) {
-              std::cerr << "HR not number: '" << *hrStrOpt << "'\n";
-            } catch (const std::out_of_range&) {
-              std::cerr << "HR out of range: '" << *hrStrOpt << "'\n";
-            }
-          }
-
-          boost::optional < std::string > cadStrOpt = trkptV.second.get_optional < std::string > ("extensions.ns3:TrackPointExtension.ns3:cad");
-          if (cadStrOpt) {
-            try {
-              int cad = std::stoi(*cadStrOpt);
-              cadences.push_back(cad);
-            } catch (const std::invalid_argument&) {
-              std::cerr << "Cadence not number: '" << *cadStrOpt << "'\n";
-            } catch (const std::out_of_range&) {
-              std::cerr << "Cadence out of range: '" << *cadStrOpt << "'\n";
-            }
-          }
-        }
-      }
-    } catch (const boost::property_tree::ptree_bad_path& e) {
-      std::cerr << "GPX path missing:" << e.what() << '\n';
-    }
-    if (!heartRates.empty()) {
-      long long sumHeartRates = std::accumulate(heartRates.begin(), heartRates.end(), 0LL);
-      result.avgHeart = static_cast< int >(sumHeartRates / heartRates.size());
-      result.maxHeart = *std::max_element(heartRates.begin(), heartRates.end());
-    }
-
-    if (!cadences.empty()) {
-      long long sumCadences = std::accumulate(cadences.begin(), cadences.end(), 0LL);
-      result.cadence = static_cast< int >(sumCadences / cadences.size());
-    }
-
-    boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
-    if (!startTimePt.is_special()) {
-      boost::posix_time::time_duration diff = startTimePt - epoch;
-      result.timeStart = diff.total_seconds();
-    }
-    if (!endTimePt.is_special()) {
-      boost::posix_time::time_duration diff = endTimePt - epoch;
-      result.timeEnd = diff.total_seconds();
-    }
-
-    if (result.distance > 0 && result.timeEnd > result.timeStart) {
-      long long durationSeconds = result.timeEnd - result.timeStart;
-      double durationMinutes = static_cast < double > (durationSeconds) / 60.0;
-      result.avgPaceMinPerKm = durationMinutes / result.distance;
+  void appendUtf8(std::string& out, unsigned long code)
+  {
+    if (code < 0x80) {
+      out.push_back(static_cast< char >(code));
+    } else if (code < 0x800) {
+      out.push_back(static_cast< char >(0xC0 | (code >> 6)));
+      out.push_back(static_cast< char >(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+      out.push_back(static_cast< char >(0xE0 | (code >> 12)));
+      out.push_back(static_cast< char >(0x80 | ((code >> 6) & 0x3F)));
+      out.push_back(static_cast< char >(0x80 | (code & 0x3F)));
     } else {
-      result.avgPaceMinPerKm = 0.0;
+      out.push_back(static_cast< char >(0xF0 | (code >> 18)));
+      out.push_back(static_cast< char >(0x80 | ((code >> 12) & 0x3F)));
+      out.push_back(static_cast< char >(0x80 | ((code >> 6) & 0x3F)));
+      out.push_back(static_cast< char >(0x80 | (code & 0x3F)));
+    }
+  }
+
+  void decodeEntities(std::string& text)
+  {
+    if (text.find('&') == std::string::npos) {
+      return;
     }
+    std::string decoded;
+    decoded.reserve(text.size());
+    size_t pos = 0;
+    while (pos < text.size()) {
+      size_t semicolon = text.find(';', pos);
+      if (text[pos] != '&' || semicolon == std::string::npos) {
+        decoded.push_back(text[pos++]);
+        continue;
+      }
+      std::string entity = text.substr(pos + 1, semicolon - pos - 1);
+      if (entity == "lt") {
+        decoded.push_back('<');
+      } else if (entity == "gt") {
+        decoded.push_back('>');
+      } else if (entity == "amp") {
+        decoded.push_back('&');
+      } else if (entity == "quot") {
+        decoded.push_back('"');
+      } else if (entity == "apos") {
+        decoded.push_back('\'');
+      } else if (entity.size() > 1 && entity[0] == '#') {
+        bool hex = entity[1] == 'x';
+        appendUtf8(decoded, std::strtoul(entity.c_str() + (hex ? 2 : 1), nullptr, hex ? 16 : 10));
+      } else {
+        decoded.push_back(text[pos++]);
+        continue;
+      }
+      pos = semicolon + 1;
+    }
+    text.swap(decoded);
+  }
 
-    return result;
+  using Attributes = std::vector< std::pair< std::string, std::string > >;
+
+  template< class Handler >
+  class XmlScanner
+  {
+  public:
+    XmlScanner(std::istream& in, Handler& handler):
+      buf_(in.rdbuf()),
+      handler_(handler)
+    {}
+    void scan()
+    {
+      std::string text;
+      int c = get();
+      while (c != eof()) {
+        if (c != '<') {
+          text.push_back(std::char_traits< char >::to_char_type(c));
+          c = get();
+          continue;
+        }
+        flushText(text);
+        c = get();
+        if (c == '?') {
+          skipUntil("?>");
+        } else if (c == '!') {
+          readMarkup();
+        } else if (c == '/') {
+          readEndTag();
+        } else {
+          readStartTag(c);
+        }
+        c = get();
+      }
+      if (!open_.empty()) {
+        throw std::runtime_error("unexpected end of data");
+      }
+    }
+  private:
+    std::streambuf* buf_;
+    Handler& handler_;
+    std::vector< std::string > open_;
+    std::string name_;
+    Attributes attributes_;
+
+    static int eof()
+    {
+      return std::char_traits< char >::eof();
+    }
+    int get()
+    {
+      return buf_ ? buf_->sbumpc() : eof();
+    }
+    int require()
+    {
+      int c = get();
+      if (c == eof()) {
+        throw std::runtime_error("unexpected end of data");
+      }
+      return c;
+    }
+    static bool isSpace(int c)
+    {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+    int skipSpaces(int c)
+    {
+      while (isSpace(c)) {
+        c = require();
+      }
+      return c;
+    }
+    void skipUntil(const std::string& terminator)
+    {
+      size_t matched = 0;
+      while (matched < terminator.size()) {
+        char c = std::char_traits< char >::to_char_type(require());
+        if (c == terminator[matched]) {
+          ++matched;
+        } else {
+          matched = (c == terminator[0]) ? 1 : 0;
+        }
+      }
+    }
+    void flushText(std::string& text)
+    {
+      if (!text.empty() && !open_.empty()) {
+        decodeEntities(text);
+        handler_.characters(text);
+      }
+      text.clear();
+    }
+    void readMarkup()
+    {
+      int c = require();
+      if (c == '-') {
+        if (require() != '-') {
+          throw std::runtime_error("invalid comment");
+        }
+        skipUntil("-->");
+      } else if (c == '[') {
+        std::string keyword;
+        for (size_t i = 0; i < 6; ++i) {
+          keyword.push_back(std::char_traits< char >::to_char_type(require()));
+        }
+        if (keyword != "CDATA[") {
+          throw std::runtime_error("invalid markup");
+        }
+        std::string data;
+        while (data.size() < 3 || data.compare(data.size() - 3, 3, "]]>") != 0) {
+          data.push_back(std::char_traits< char >::to_char_type(require()));
+        }
+        data.resize(data.size() - 3);
+        if (!open_.empty()) {
+          handler_.characters(data);
+        }
+      } else {
+        int depth = 0;
+        while (c != '>' || depth > 0) {
+          depth += (c == '[') - (c == ']');
+          c = require();
+        }
+      }
+    }
+    int readName(int c)
+    {
+      name_.clear();
+      while (!isSpace(c) && c != '>' && c != '/' && c != '=') {
+        name_.push_back(std::char_traits< char >::to_char_type(c));
+        c = require();
+      }
+      if (name_.empty()) {
+        throw std::runtime_error("expected element name");
+      }
+      return c;
+    }
+    void readEndTag()
+    {
+      int c = skipSpaces(readName(require()));
+      if (c != '>') {
+        throw std::runtime_error("expected >");
+      }
+      if (open_.empty() || open_.back() != name_) {
+        throw std::runtime_error("invalid closing tag name");
+      }
+      open_.pop_back();
+      handler_.endElement();
+    }
+    void readStartTag(int c)
+    {
+      if (c == eof()) {
+        throw std::runtime_error("unexpected end of data");
+      }
+      c = skipSpaces(readName(c));
+      std::string element = name_;
+      attributes_.clear();
+      while (c != '>' && c != '/') {
+        c = skipSpaces(readName(c));
+        std::string attribute = name_;
+        if (c != '=') {
+          throw std::runtime_error("expected =");
+        }
+        int quote = skipSpaces(require());
+        if (quote != '"' && quote != '\'') {
+          throw std::runtime_error("expected ' or \"");
+        }
+        std::string value;
+        for (c = require(); c != quote; c = require()) {
+          value.push_back(std::char_traits< char >::to_char_type(c));
+        }
+        decodeEntities(value);
+        attributes_.emplace_back(std::move(attribute), std::move(value));
+        c = skipSpaces(require());
+      }
+      bool selfClosing = c == '/';
+      if (selfClosing && require() != '>') {
+        throw std::runtime_error("expected >");
+      }
+      handler_.startElement(element, attributes_);
+      if (selfClosing) {
+        handler_.endElement();
+      } else {
+        open_.push_back(std::move(element));
+      }
+    }
+  };
+
+  enum class GpxNode
+  {
+    document,
+    other,
+    gpx,
+    trk,
+    name,
+    trkseg,
+    trkpt,
+    time,
+    extensions,
+    trackPointExtension,
+    hr,
+    cad
+  };
+
+  struct TrackPoint
+  {
+    bool hasLat = false;
+    bool hasLon = false;
+    bool hasTime = false;
+    bool hasExtensions = false;
+    bool hasTrackPointExtension = false;
+    bool hasHr = false;
+    bool hasCad = false;
+    std::string lat;
+    std::string lon;
+    std::string time;
+    std::string hr;
+    std::string cad;
+  };
+
+  class GpxHandler
+  {
+  public:
+    explicit GpxHandler(std::ostream& err):
+      err_(err)
+    {}
+    void startElement(const std::string& name, const Attributes& attributes)
+    {
+      GpxNode node = classify(nodes_.empty() ? GpxNode::document : nodes_.back(), name);
+      nodes_.push_back(node);
+      if (node == GpxNode::trkpt) {
+        startPoint(attributes);
+      }
+    }
+    void characters(const std::string& text)
+    {
+      switch (nodes_.back()) {
+      case GpxNode::name:
+        name_ += text;
+        break;
+      case GpxNode::time:
+        point_.time += text;
+        break;
+      case GpxNode::hr:
+        point_.hr += text;
+        break;
+      case GpxNode::cad:
+        point_.cad += text;
+        break;
+      default:
+        break;
+      }
+    }
+    void endElement()
+    {
+      GpxNode node = nodes_.back();
+      nodes_.pop_back();
+      if (node == GpxNode::trkpt && !stopped_) {
+        addPoint();
+      }
+    }
+    dribas::workout result() const
+    {
+      dribas::workout result;
+      result.name = hasName_ ? name_ : "Unknown workout";
+      if (!hasTrkseg_) {
+        err_ << "GPX path missing:" << "No such node (gpx.trk.trkseg)" << '\n';
+      }
+      result.distance = distance_;
+      if (heartRateCount_ != 0) {
+        result.avgHeart = static_cast< int >(sumHeartRates_ / heartRateCount_);
+        result.maxHeart = maxHeart_;
+      }
+      if (cadenceCount_ != 0) {
+        result.cadence = static_cast< int >(sumCadences_ / cadenceCount_);
+      }
+      result.timeStart = hasStart_ ? startTime_ : 0;
+      result.timeEnd = hasEnd_ ? endTime_ : 0;
+      if (result.distance > 0 && result.timeEnd > result.timeStart) {
+        long long durationSeconds = result.timeEnd - result.timeStart;
+        double durationMinutes = static_cast< double >(durationSeconds) / 60.0;
+        result.avgPaceMinPerKm = durationMinutes / result.distance;
+      } else {
+        result.avgPaceMinPerKm = 0.0;
+      }
+      return result;
+    }
+  private:
+    std::ostream& err_;
+    std::vector< GpxNode > nodes_;
+    TrackPoint point_;
+    bool hasGpx_ = false;
+    bool hasTrk_ = false;
+    bool hasName_ = false;
+    bool hasTrkseg_ = false;
+    bool stopped_ = false;
+    std::string name_;
+
+    bool firstPoint_ = true;
+    double prevLat_ = 0.0;
+    double prevLon_ = 0.0;
+    double distance_ = 0.0;
+    bool hasStart_ = false;
+    bool hasEnd_ = false;
+    long long startTime_ = 0;
+    long long endTime_ = 0;
+    long long sumHeartRates_ = 0;
+    size_t heartRateCount_ = 0;
+    int maxHeart_ = 0;
+    long long sumCadences_ = 0;
+    size_t cadenceCount_ = 0;
+
+    static bool claim(bool& seen)
+    {
+      bool first = !seen;
+      seen = true;
+      return first;
+    }
+    GpxNode classify(GpxNode parent, const std::string& name)
+    {
+      switch (parent) {
+      case GpxNode::document:
+        return name == "gpx" && claim(hasGpx_) ? GpxNode::gpx : GpxNode::other;
+      case GpxNode::gpx:
+        return name == "trk" && claim(hasTrk_) ? GpxNode::trk : GpxNode::other;
+      case GpxNode::trk:
+        if (name == "name" && claim(hasName_)) {
+          return GpxNode::name;
+        }
+        return name == "trkseg" && claim(hasTrkseg_) ? GpxNode::trkseg : GpxNode::other;
+      case GpxNode::trkseg:
+        return name == "trkpt" ? GpxNode::trkpt : GpxNode::other;
+      case GpxNode::trkpt:
+        if (name == "time" && claim(point_.hasTime)) {
+          return GpxNode::time;
+        }
+        return name == "extensions" && claim(point_.hasExtensions) ? GpxNode::extensions : GpxNode::other;
+      case GpxNode::extensions:
+        if (name == "ns3:TrackPointExtension" && claim(point_.hasTrackPointExtension)) {
+          return GpxNode::trackPointExtension;
+        }
+        return GpxNode::other;
+      case GpxNode::trackPointExtension:
+        if (name == "ns3:hr" && claim(point_.hasHr)) {
+          return GpxNode::hr;
+        }
+        return name == "ns3:cad" && claim(point_.hasCad) ? GpxNode::cad : GpxNode::other;
+      default:
+        return GpxNode::other;
+      }
+    }
+    void startPoint(const Attributes& attributes)
+    {
+      point_.hasLat = false;
+      point_.hasLon = false;
+      point_.hasTime = false;
+      point_.hasExtensions = false;
+      point_.hasTrackPointExtension = false;
+      point_.hasHr = false;
+      point_.hasCad = false;
+      point_.time.clear();
+      point_.hr.clear();
+      point_.cad.clear();
+      for (auto it = attributes.begin(); it != attributes.end(); ++it) {
+        if (it->first == "lat" && claim(point_.hasLat)) {
+          point_.lat = it->second;
+        } else if (it->first == "lon" && claim(point_.hasLon)) {
+          point_.lon = it->second;
+        }
+      }
+    }
+    void addPoint()
+    {
+      if (!point_.hasTime) {
+        err_ << "GPX path missing:" << "No such node (time)" << '\n';
+        stopped_ = true;
+        return;
+      }
+      std::string& timeStr = point_.time;
+      size_t dotPos = timeStr.find('.');
+      if (dotPos != std::string::npos) {
+        timeStr.resize(dotPos);
+      }
+      if (!timeStr.empty() && timeStr.back() == 'Z') {
+        timeStr.pop_back();
+      }
+      long long timestamp = 0;
+      if (parseTimestamp(timeStr, timestamp)) {
+        if (firstPoint_) {
+          startTime_ = timestamp;
+          hasStart_ = true;
+        }
+        endTime_ = timestamp;
+        hasEnd_ = true;
+      } else {
+        err_ << "Time error: '" << timeStr << "' - Time parse failed: " << timeStr << '\n';
+      }
+
+      double currentLat = 0.0;
+      double currentLon = 0.0;
+      if (!readCoordinate(point_.hasLat, point_.lat, "lat", currentLat)) {
+        return;
+      }
+      if (!readCoordinate(point_.hasLon, point_.lon, "lon", currentLon)) {
+        return;
+      }
+      if (!firstPoint_) {
+        distance_ += calculateDistance(prevLat_, prevLon_, currentLat, currentLon);
+      } else {
+        firstPoint_ = false;
+      }
+      prevLat_ = currentLat;
+      prevLon_ = currentLon;
+
+      if (point_.hasHr) {
+        try {
+          int hr = std::stoi(point_.hr);
+          sumHeartRates_ += hr;
+          maxHeart_ = heartRateCount_ == 0 ? hr : std::max(maxHeart_, hr);
+          ++heartRateCount_;
+        } catch (const std::invalid_argument&) {
+          err_ << "HR not number: '" << point_.hr << "'\n";
+        } catch (const std::out_of_range&) {
+          err_ << "HR out of range: '" << point_.hr << "'\n";
+        }
+      }
+      if (point_.hasCad) {
+        try {
+          int cad = std::stoi(point_.cad);
+          sumCadences_ += cad;
+          ++cadenceCount_;
+        } catch (const std::invalid_argument&) {
+          err_ << "Cadence not number: '" << point_.cad << "'\n";
+        } catch (const std::out_of_range&) {
+          err_ << "Cadence out of range: '" << point_.cad << "'\n";
+        }
+      }
+    }
+    bool readCoordinate(bool present, const std::string& str, const char* attribute, double& value)
+    {
+      if (!present) {
+        err_ << "No coords in trkpt: No such node (<xmlattr>." << attribute << ")\n";
+        firstPoint_ = true;
+        return false;
+      }
+      if (!parseCoordinate(str, value)) {
+        err_ << "Coord error: conversion of data to type \"d\" failed\n";
+        firstPoint_ = true;
+        return false;
+      }
+      return true;
+    }
+  };
+}
+
+namespace dribas
+{
+  workout parseGpx(std::istream& gpxStream, std::ostream& err)
+  {
+    GpxHandler handler(err);
+    try {
+      XmlScanner< GpxHandler >(gpxStream, handler).scan();
+    } catch (const std::runtime_error& e) {
+      err << "XML error: " << e.what() << '\n';
+      return workout();
+    }
+    return handler.result();
   }
 
   std::istream& operator>>(std::istream& is, workout& w)
@@ -183,7 +621,7 @@ namespace dribas
     }
     dribas::StreamGuard guard(is);
     is.unsetf(std::ios_base::skipws);
-    w = parseGpx(is);
+    w = parseGpx(is, std::cerr);
     return is;
   }
 
@@ -23,12 +23,7 @@ namespace dribas
     time_t timeEnd = 0;
   };
 
-  struct training_suite
-  {
-    std::map< size_t, std::map< time_t, workout > > suite;
-  };
-
-  workout parseGpx(const std::string& gpxContent);
+  workout parseGpx(std::istream& gpxStream, std::ostream& err);
 
   std::istream& operator>>(std::istream& is, workout& w);
   std::ostream& operator<<(std::ostream& os, const workout& w);
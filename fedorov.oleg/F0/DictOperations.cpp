@@ -8,6 +8,8 @@
 #include <map>
 #include <set>
 #include <numeric>
+#include <future>
+#include <thread>
 
 #include "TextProcessor.hpp"
 #include "Utility.hpp"
@@ -171,26 +173,21 @@ namespace crossref
         processDictLine(table, line);
       }
     };
-  }
-
-  void TextProcessor::buildDict(const std::string &dict_id, const std::string &text_id)
-  {
-    validation::checkIdExists(dicts, dict_id, "<DICT ID EXISTS>");
-    validation::checkIdNotFound(texts, text_id, "<TEXT NOT FOUND>");
 
-    HashTable table;
-    dictWordOrder.erase(dict_id);
-    auto &wordOrder = dictWordOrder[dict_id];
+    using WordOrder = std::map< int, std::vector< std::string > >;
+    const size_t minShardLines = 4096;
 
-    int line_num = 1;
-    const auto &text_lines = texts.find(text_id)->second;
+    struct DictShard
+    {
+      HashTable table;
+      WordOrder wordOrder;
+    };
 
-    struct LineProcessor
+    struct ShardLineProcessor
     {
       HashTable &table;
-      std::map< int, std::vector< std::string > > &wordOrder;
+      WordOrder &wordOrder;
       int &line_num;
-      const TextProcessor &processor;
 
       void operator()(const std::string &line) const
       {
@@ -200,18 +197,17 @@ namespace crossref
         std::vector< std::string > cleanWords;
         struct WordCleaner
         {
-          const TextProcessor &processor;
           std::vector< std::string > &cleanWords;
           void operator()(const std::string &word) const
           {
-            std::string clean = processor.sanitizeWord(word);
+            std::string clean = TextProcessor::sanitizeWord(word);
             if (!clean.empty())
             {
               cleanWords.push_back(clean);
             }
           }
         };
-        std::for_each(words.begin(), words.end(), WordCleaner{processor, cleanWords});
+        std::for_each(words.begin(), words.end(), WordCleaner{cleanWords});
 
         struct WordInserter
         {
@@ -226,16 +222,88 @@ namespace crossref
 
         if (!cleanWords.empty())
         {
-          wordOrder[line_num] = cleanWords;
+          wordOrder[line_num] = std::move(cleanWords);
         }
         line_num++;
       }
     };
 
-    LineProcessor processor{table, wordOrder, line_num, *this};
-    std::for_each(text_lines.begin(), text_lines.end(), processor);
+    struct ShardBuilder
+    {
+      const std::vector< std::string > &lines;
+      size_t shardSize;
+
+      DictShard operator()(size_t shard) const
+      {
+        size_t first = std::min(shard * shardSize, lines.size());
+        size_t last = std::min(first + shardSize, lines.size());
+        int line_num = static_cast< int >(first) + 1;
+
+        DictShard result;
+        ShardLineProcessor processor{result.table, result.wordOrder, line_num};
+        std::for_each(lines.begin() + first, lines.begin() + last, processor);
+        return result;
+      }
+    };
+
+    struct ShardLauncher
+    {
+      ShardBuilder builder;
+
+      std::future< DictShard > operator()(size_t shard) const
+      {
+        return std::async(std::launch::async, builder, shard);
+      }
+    };
+
+    struct ShardMerger
+    {
+      DictShard &dict;
+
+      void operator()(std::future< DictShard > &future) const
+      {
+        DictShard shard = future.get();
+        dict.table.merge(std::move(shard.table));
+        auto first = std::make_move_iterator(shard.wordOrder.begin());
+        auto last = std::make_move_iterator(shard.wordOrder.end());
+        dict.wordOrder.insert(first, last);
+      }
+    };
+
+    size_t countShards(size_t lines)
+    {
+      size_t threads = std::max< size_t >(std::thread::hardware_concurrency(), 1);
+      return std::max< size_t >(std::min(threads, lines / minShardLines), 1);
+    }
+  }
+
+  void TextProcessor::buildDict(const std::string &dict_id, const std::string &text_id)
+  {
+    validation::checkIdExists(dicts, dict_id, "<DICT ID EXISTS>");
+    validation::checkIdNotFound(texts, text_id, "<TEXT NOT FOUND>");
+
+    const auto &text_lines = texts.find(text_id)->second;
+    size_t shards = countShards(text_lines.size());
+    ShardBuilder builder{text_lines, (text_lines.size() + shards - 1) / shards};
+
+    DictShard dict;
+    if (shards == 1)
+    {
+      dict = builder(0);
+    }
+    else
+    {
+      std::vector< size_t > ids(shards);
+      std::iota(ids.begin(), ids.end(), 0);
+      std::vector< std::future< DictShard > > futures;
+      std::transform(ids.begin(), ids.end(), std::back_inserter(futures), ShardLauncher{builder});
+
+      dict = futures.front().get();
+      std::for_each(std::next(futures.begin()), futures.end(), ShardMerger{dict});
+    }
 
-    dicts[dict_id] = table;
+    dictWordOrder[dict_id] = std::move(dict.wordOrder);
+    dicts[dict_id] = std::move(dict.table);
   }
 
   void TextProcessor::showDict(const std::string &dict_id) const
@@ -292,7 +360,7 @@ namespace crossref
     DictLineHandler handler(table);
     std::for_each(file_lines.begin(), file_lines.end(), handler);
 
-    dicts[dict_id] = table;
+    dicts[dict_id] = std::move(table);
   }
 
   void TextProcessor::exportDict(const std::string &dict_id, const std::string &filename) const
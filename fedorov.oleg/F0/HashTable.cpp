@@ -1,84 +1,67 @@
 #include "HashTable.hpp"
 
 #include <algorithm>
-#include <cmath>
-#include <stdexcept>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <vector>
-#include <list>
-#include <numeric>
 
-namespace
+namespace crossref
 {
 
-  bool isPrimeRecursive(size_t n, size_t i)
+  HashTable::RehashHelper::RehashHelper(HashTable *t):
+    table(t)
+  {}
+  HashTable::MergeHelper::MergeHelper(HashTable *t):
+    table(t)
+  {}
+  HashTable::EmplaceHelper::EmplaceHelper(decltype(entries) &e):
+    entries(e)
+  {}
+
+  void HashTable::RehashHelper::operator()(HashEntry &entry) const
   {
-    if (i * i > n)
-    {
-      return false;
-    }
-    if (n % i == 0 || n % (i + 2) == 0)
+    if (entry.distance != 0)
     {
-      return true;
+      entry.distance = 1;
+      table->place(entry, entry.hash & table->mask);
     }
-    return isPrimeRecursive(n, i + 6);
   }
 
-  bool isPrime(size_t n)
+  void HashTable::MergeHelper::operator()(HashEntry &entry) const
   {
-    if (n <= 1)
+    if (entry.distance == 0)
     {
-      return false;
+      return;
     }
-    if (n <= 3)
+    size_t pos = table->findPosition(entry.word, entry.hash);
+    if (pos == table->table.size())
     {
-      return true;
+      table->emplace(entry);
+      return;
     }
-    if (n % 2 == 0 || n % 3 == 0)
+    std::vector< int > &lines = table->table[pos].lines;
+    if (lines.back() < entry.lines.front())
     {
-      return false;
+      lines.insert(lines.end(), entry.lines.begin(), entry.lines.end());
+      return;
     }
-    return !isPrimeRecursive(n, 5);
-  }
-
-}
-
-namespace crossref
-{
-
-  HashTable::RehashHelper::RehashHelper(HashTable *t):
-    table(t)
-  {}
-  HashTable::EmplaceHelper::EmplaceHelper(decltype(entries) &e):
-    entries(e)
-  {}
-
-  void HashTable::RehashHelper::operator()(const HashEntry &entry) const
-  {
-    if (entry.isActive && !entry.word.empty())
+    struct LineAdder
     {
-      struct InsertLine
+      std::vector< int > &lines;
+      void operator()(int line) const
       {
-        HashTable *table;
-        std::string word;
-        InsertLine(HashTable *t, const std::string &w):
-          table(t),
-          word(w)
-        {}
-        void operator()(int line) const
-        {
-          table->insert(word, line);
-        }
-      };
-
-      std::for_each(entry.lines.begin(), entry.lines.end(), InsertLine(table, entry.word));
-    }
+        addLine(lines, line);
+      }
+    };
+    std::for_each(entry.lines.begin(), entry.lines.end(), LineAdder{lines});
   }
 
   void HashTable::EmplaceHelper::operator()(const HashEntry &entry) const
   {
-    if (entry.isActive && !entry.word.empty())
+    if (entry.distance != 0)
     {
-      entries.emplace_back(entry.word, std::vector< int >(entry.lines.begin(), entry.lines.end()));
+      entries.push_back(std::addressof(entry));
     }
   }
 
@@ -86,133 +69,181 @@ namespace crossref
   {
     entry.word.clear();
     entry.lines.clear();
-    entry.isActive = false;
+    entry.hash = 0;
+    entry.distance = 0;
   }
 
   HashTable::HashTable(size_t size):
-    table(size),
-    itemCount(0)
+    table(roundUpPowerOfTwo(size, 8)),
+    itemCount(0),
+    mask(table.size() - 1)
   {}
 
-  struct HashAccumulator
+  size_t HashTable::roundUpPowerOfTwo(size_t n, size_t power)
   {
-    size_t operator()(size_t hashValue, unsigned char c) const
+    if (power >= n)
     {
-      return (hashValue * 31) + c;
+      return power;
     }
-  };
+    return roundUpPowerOfTwo(n, power * 2);
+  }
 
-  size_t HashTable::hash(const std::string &key) const
+  size_t HashTable::hash(const std::string &key)
   {
-    size_t init = 0;
-    return std::accumulate(key.begin(), key.end(), init, HashAccumulator()) % table.size();
+    return std::hash< std::string >{}(key);
   }
 
-  size_t HashTable::findPosition(const std::string &key) const
+  size_t HashTable::findPosition(const std::string &key, size_t keyHash) const
   {
-    return findPosition(key, hash(key), 0);
+    return findPosition(key, keyHash, keyHash & mask, 1);
   }
 
-  size_t HashTable::findPosition(const std::string &key, size_t current, size_t i) const
+  size_t HashTable::findPosition(const std::string &key, size_t keyHash, size_t current, size_t distance) const
   {
-    if (!table[current].isActive || table[current].word == key)
+    const HashEntry &entry = table[current];
+    if (entry.distance < distance)
     {
-      return current;
+      return table.size();
     }
-    if (i >= table.size())
+    if (entry.hash == keyHash && entry.word == key)
     {
       return current;
     }
+    return findPosition(key, keyHash, (current + 1) & mask, distance + 1);
+  }
+
+  void HashTable::place(HashEntry &entry, size_t current)
+  {
+    HashEntry &slot = table[current];
+    if (slot.distance == 0)
+    {
+      slot = std::move(entry);
+      return;
+    }
+    if (slot.distance < entry.distance)
+    {
+      std::swap(slot, entry);
+    }
+    entry.distance++;
+    place(entry, (current + 1) & mask);
+  }
 
-    size_t next_i = i + 1;
-    size_t next = (current + next_i * next_i) % table.size();
-    return findPosition(key, next, next_i);
+  void HashTable::shiftBack(size_t current)
+  {
+    size_t next = (current + 1) & mask;
+    if (table[next].distance <= 1)
+    {
+      ClearHelper()(table[current]);
+      return;
+    }
+    table[current] = std::move(table[next]);
+    table[current].distance--;
+    shiftBack(next);
   }
 
-  size_t HashTable::nextPrime(size_t n) const
+  void HashTable::addLine(std::vector< int > &lines, int line)
   {
-    if (n % 2 == 0)
+    if (lines.empty() || lines.back() < line)
     {
-      n++;
+      lines.push_back(line);
+      return;
     }
-    if (isPrime(n))
+    auto it = std::lower_bound(lines.begin(), lines.end(), line);
+    if (*it != line)
     {
-      return n;
+      lines.insert(it, line);
     }
-    return nextPrime(n + 2);
   }
 
   void HashTable::rehash()
   {
-    std::vector< HashEntry > oldTable = std::move(table);
-    table = std::vector< HashEntry >(nextPrime(oldTable.size() * 2));
-    itemCount = 0;
+    std::vector< HashEntry > oldTable(table.size() * 2);
+    oldTable.swap(table);
+    mask = table.size() - 1;
 
     std::for_each(oldTable.begin(), oldTable.end(), RehashHelper(this));
   }
 
   void HashTable::insert(const std::string &key, int line)
   {
-    if (itemCount >= table.size() * 0.75)
+    size_t keyHash = hash(key);
+    size_t pos = findPosition(key, keyHash);
+
+    if (pos != table.size())
     {
-      rehash();
+      addLine(table[pos].lines, line);
+      return;
     }
 
-    size_t pos = findPosition(key);
+    HashEntry entry{key, {line}, keyHash, 1};
+    emplace(entry);
+  }
 
-    if (!table[pos].isActive)
+  void HashTable::emplace(HashEntry &entry)
+  {
+    if ((itemCount + 1) * 8 > table.size() * 7)
     {
-      table[pos].word = key;
-      table[pos].isActive = true;
-      itemCount++;
+      rehash();
     }
+    entry.distance = 1;
+    place(entry, entry.hash & mask);
+    itemCount++;
+  }
 
-    if (std::find(table[pos].lines.begin(), table[pos].lines.end(), line) == table[pos].lines.end())
-    {
-      table[pos].lines.push_back(line);
-      table[pos].lines.sort();
-    }
+  void HashTable::merge(HashTable &&other)
+  {
+    std::for_each(other.table.begin(), other.table.end(), MergeHelper(this));
+    other.clear();
   }
 
   void HashTable::remove(const std::string &key)
   {
-    size_t pos = findPosition(key);
+    size_t pos = findPosition(key, hash(key));
 
-    if (table[pos].isActive && table[pos].word == key)
+    if (pos != table.size())
     {
-      table[pos].isActive = false;
-      table[pos].lines.clear();
+      shiftBack(pos);
       itemCount--;
     }
   }
 
   std::vector< int > HashTable::find(const std::string &key) const
   {
-    size_t pos = findPosition(key);
+    size_t pos = findPosition(key, hash(key));
 
-    if (table[pos].isActive && table[pos].word == key)
+    if (pos != table.size())
     {
-      return std::vector< int >(table[pos].lines.begin(), table[pos].lines.end());
+      return table[pos].lines;
     }
     return {};
   }
 
   struct HashTable::EntryComparator
   {
-    using type_entry = std::pair< std::string, std::vector< int > >;
-    bool operator()(const type_entry &a, const type_entry &b) const
+    bool operator()(const HashEntry *a, const HashEntry *b) const
     {
-      return a.first < b.first;
+      return a->word < b->word;
     }
   };
 
   std::vector< std::pair< std::string, std::vector< int > > > HashTable::getSortedEntries() const
   {
-    std::vector< std::pair< std::string, std::vector< int > > > entries;
+    std::vector< const HashEntry * > active;
+    active.reserve(itemCount);
+    std::for_each(table.begin(), table.end(), EmplaceHelper(active));
+    std::sort(active.begin(), active.end(), EntryComparator());
 
-    std::for_each(table.begin(), table.end(), EmplaceHelper(entries));
+    struct EntryCopier
+    {
+      std::pair< std::string, std::vector< int > > operator()(const HashEntry *entry) const
+      {
+        return {entry->word, entry->lines};
+      }
+    };
 
-    std::sort(entries.begin(), entries.end(), EntryComparator());
+    std::vector< std::pair< std::string, std::vector< int > > > entries;
+    entries.reserve(active.size());
+    std::transform(active.begin(), active.end(), std::back_inserter(entries), EntryCopier());
     return entries;
   }
 
@@ -3,7 +3,6 @@
 
 #include <vector>
 #include <string>
-#include <list>
 #include <utility>
 
 namespace crossref
@@ -12,12 +11,14 @@ namespace crossref
   class HashTable
   {
     struct RehashHelper;
+    struct MergeHelper;
     struct EmplaceHelper;
     struct ClearHelper;
 
   public:
-    explicit HashTable(size_t size = 101);
+    explicit HashTable(size_t size = 128);
     void insert(const std::string &key, int line);
+    void merge(HashTable &&other);
     void remove(const std::string &key);
     std::vector< int > find(const std::string &key) const;
     std::vector< std::pair< std::string, std::vector< int > > > getSortedEntries() const;
@@ -31,21 +32,28 @@ namespace crossref
     struct HashEntry
     {
       std::string word;
-      std::list< int > lines;
-      bool isActive;
+      std::vector< int > lines;
+      size_t hash;
+      size_t distance;
     };
 
     std::vector< HashEntry > table;
     size_t itemCount;
+    size_t mask;
 
-    size_t findPosition(const std::string &key) const;
-    size_t findPosition(const std::string &key, size_t current, size_t i) const;
-    size_t nextPrime(size_t n) const;
+    size_t findPosition(const std::string &key, size_t keyHash) const;
+    size_t findPosition(const std::string &key, size_t keyHash, size_t current, size_t distance) const;
+    void place(HashEntry &entry, size_t current);
+    void emplace(HashEntry &entry);
+    void shiftBack(size_t current);
+    static void addLine(std::vector< int > &lines, int line);
+    static size_t roundUpPowerOfTwo(size_t n, size_t power);
 
     void rehash();
-    size_t hash(const std::string &key) const;
+    static size_t hash(const std::string &key);
 
     friend struct RehashHelper;
+    friend struct MergeHelper;
     friend struct EmplaceHelper;
     friend struct ClearHelper;
   };
@@ -54,12 +62,19 @@ namespace crossref
   {
     HashTable *table;
     RehashHelper(HashTable *t);
-    void operator()(const HashEntry &entry) const;
+    void operator()(HashEntry &entry) const;
+  };
+
+  struct HashTable::MergeHelper
+  {
+    HashTable *table;
+    MergeHelper(HashTable *t);
+    void operator()(HashEntry &entry) const;
   };
 
   struct HashTable::EmplaceHelper
   {
-    std::vector< std::pair< std::string, std::vector< int > > > &entries;
+    std::vector< const HashEntry * > &entries;
     EmplaceHelper(decltype(entries) &e);
     void operator()(const HashEntry &entry) const;
   };
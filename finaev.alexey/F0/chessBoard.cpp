@@ -0,0 +1,343 @@
+#include "chessBoard.hpp"
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <cctype>
+
+namespace
+{
+  using bitboard = std::uint64_t;
+
+  const int rookDirections[] = { 0, 1, 4, 5 };
+  const int bishopDirections[] = { 2, 3, 6, 7 };
+
+  bitboard bit(int square)
+  {
+    return bitboard(1) << square;
+  }
+
+  int lowest(bitboard board)
+  {
+    return __builtin_ctzll(board);
+  }
+
+  int highest(bitboard board)
+  {
+    return 63 - __builtin_clzll(board);
+  }
+
+  bitboard at(int file, int rank)
+  {
+    return (file >= 0 && file < 8 && rank >= 0 && rank < 8) ? bit(rank * 8 + file) : 0;
+  }
+
+  bitboard rayFrom(int file, int rank, const int (&step)[2])
+  {
+    bitboard next = at(file + step[0], rank + step[1]);
+    return next ? next | rayFrom(file + step[0], rank + step[1], step) : 0;
+  }
+
+  struct StepAdder
+  {
+    int file;
+    int rank;
+
+    bitboard operator()(bitboard result, const int (&offset)[2]) const
+    {
+      return result | at(file + offset[0], rank + offset[1]);
+    }
+  };
+
+  template< size_t N >
+  struct StepAttacks
+  {
+    const int (&offsets)[N][2];
+
+    bitboard operator()(int square) const
+    {
+      return std::accumulate(std::begin(offsets), std::end(offsets), bitboard(0), StepAdder{ square % 8, square / 8 });
+    }
+  };
+
+  struct RayAttacks
+  {
+    const int (&step)[2];
+
+    bitboard operator()(int square) const
+    {
+      return rayFrom(square % 8, square / 8, step);
+    }
+  };
+
+  struct RayTableFill
+  {
+    const int (&squares)[64];
+    const int (*step)[2];
+
+    void operator()(bitboard (&table)[64])
+    {
+      std::transform(std::begin(squares), std::end(squares), table, RayAttacks{ *step++ });
+    }
+  };
+
+  struct AttackTables
+  {
+    bitboard knight[64];
+    bitboard king[64];
+    bitboard pawn[2][64];
+    bitboard rays[8][64];
+
+    AttackTables()
+    {
+      const int knightSteps[8][2] = { {1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2} };
+      const int kingSteps[8][2] = { {0, 1}, {1, 0}, {1, 1}, {-1, 1}, {0, -1}, {-1, 0}, {1, -1}, {-1, -1} };
+      const int pawnSteps[2][2][2] = { { {-1, 1}, {1, 1} }, { {-1, -1}, {1, -1} } };
+      int squares[64];
+      std::iota(std::begin(squares), std::end(squares), 0);
+      std::transform(std::begin(squares), std::end(squares), knight, StepAttacks< 8 >{ knightSteps });
+      std::transform(std::begin(squares), std::end(squares), king, StepAttacks< 8 >{ kingSteps });
+      std::transform(std::begin(squares), std::end(squares), pawn[0], StepAttacks< 2 >{ pawnSteps[0] });
+      std::transform(std::begin(squares), std::end(squares), pawn[1], StepAttacks< 2 >{ pawnSteps[1] });
+      std::for_each(std::begin(rays), std::end(rays), RayTableFill{ squares, kingSteps });
+    }
+  };
+
+  const AttackTables& tables()
+  {
+    static const AttackTables instance;
+    return instance;
+  }
+
+  bitboard rayAttacks(int dir, int square, bitboard occupied)
+  {
+    bitboard ray = tables().rays[dir][square];
+    bitboard blockers = ray & occupied;
+    if (blockers)
+    {
+      ray ^= tables().rays[dir][dir < 4 ? lowest(blockers) : highest(blockers)];
+    }
+    return ray;
+  }
+
+  struct RayUnion
+  {
+    int square;
+    bitboard occupied;
+
+    bitboard operator()(bitboard result, int dir) const
+    {
+      return result | rayAttacks(dir, square, occupied);
+    }
+  };
+
+  template< size_t N >
+  bitboard sliderAttacks(const int (&directions)[N], int square, bitboard occupied)
+  {
+    return std::accumulate(std::begin(directions), std::end(directions), bitboard(0), RayUnion{ square, occupied });
+  }
+
+  int parseSquare(char file, char rank)
+  {
+    file = std::tolower(file);
+    if (file < 'a' || file > 'h' || rank < '1' || rank > '8')
+    {
+      return -1;
+    }
+    return (rank - '1') * 8 + (file - 'a');
+  }
+
+  int castlingKept(int square)
+  {
+    switch (square)
+    {
+    case 0:
+      return ~2;
+    case 4:
+      return ~3;
+    case 7:
+      return ~1;
+    case 56:
+      return ~8;
+    case 60:
+      return ~12;
+    case 63:
+      return ~4;
+    default:
+      return ~0;
+    }
+  }
+
+  struct Occupies
+  {
+    bitboard square;
+
+    bool operator()(bitboard board) const
+    {
+      return board & square;
+    }
+  };
+
+  struct MovePlayer
+  {
+    finaev::ChessBoard& board;
+
+    bool operator()(const std::string& move) const
+    {
+      return board.play(move);
+    }
+  };
+}
+
+finaev::ChessBoard::ChessBoard():
+  pieces_{
+    { 0x000000000000FF00, 0x0000000000000042, 0x0000000000000024, 0x0000000000000081, 0x0000000000000008, 0x0000000000000010 },
+    { 0x00FF000000000000, 0x4200000000000000, 0x2400000000000000, 0x8100000000000000, 0x0800000000000000, 0x1000000000000000 }
+  },
+  colors_{ 0x000000000000FFFF, 0xFFFF000000000000 },
+  side_(0),
+  castling_(15),
+  enPassant_(-1)
+{}
+
+bool finaev::ChessBoard::play(const std::string& move)
+{
+  if (move.length() != 5 || move[2] != '-')
+  {
+    return false;
+  }
+  int from = parseSquare(move[0], move[1]);
+  int to = parseSquare(move[3], move[4]);
+  if (from < 0 || to < 0 || (colors_[side_] & bit(to)))
+  {
+    return false;
+  }
+  Piece piece = pieceAt(side_, from);
+  if (piece == NONE || !(canReach(piece, from, to) || (piece == KING && canCastle(from, to))))
+  {
+    return false;
+  }
+  ChessBoard next = *this;
+  next.apply(piece, from, to);
+  if (next.attacked(lowest(next.pieces_[side_][KING]), next.side_))
+  {
+    return false;
+  }
+  *this = next;
+  return true;
+}
+
+finaev::ChessBoard::Piece finaev::ChessBoard::pieceAt(int color, int square) const
+{
+  if (!(colors_[color] & bit(square)))
+  {
+    return NONE;
+  }
+  const bitboard* boards = pieces_[color];
+  return static_cast< Piece >(std::find_if(boards, boards + NONE, Occupies{ bit(square) }) - boards);
+}
+
+bool finaev::ChessBoard::canReach(Piece piece, int from, int to) const
+{
+  bitboard occupied = colors_[0] | colors_[1];
+  switch (piece)
+  {
+  case PAWN:
+  {
+    int forward = side_ == 0 ? 8 : -8;
+    int startRank = side_ == 0 ? 1 : 6;
+    if (tables().pawn[side_][from] & bit(to))
+    {
+      return (colors_[1 - side_] & bit(to)) || to == enPassant_;
+    }
+    if (to == from + forward)
+    {
+      return !(occupied & bit(to));
+    }
+    return from / 8 == startRank && to == from + 2 * forward && !(occupied & (bit(from + forward) | bit(to)));
+  }
+  case KNIGHT:
+    return tables().knight[from] & bit(to);
+  case BISHOP:
+    return sliderAttacks(bishopDirections, from, occupied) & bit(to);
+  case ROOK:
+    return sliderAttacks(rookDirections, from, occupied) & bit(to);
+  case QUEEN:
+    return (sliderAttacks(bishopDirections, from, occupied) | sliderAttacks(rookDirections, from, occupied)) & bit(to);
+  case KING:
+    return tables().king[from] & bit(to);
+  default:
+    return false;
+  }
+}
+
+bool finaev::ChessBoard::canCastle(int from, int to) const
+{
+  int home = side_ == 0 ? 4 : 60;
+  int enemy = 1 - side_;
+  bitboard occupied = colors_[0] | colors_[1];
+  if (from != home || attacked(home, enemy))
+  {
+    return false;
+  }
+  if (to == home + 2)
+  {
+    return (castling_ & (side_ == 0 ? 1 : 4)) && !(occupied & (bit(home + 1) | bit(home + 2)))
+        && !attacked(home + 1, enemy) && !attacked(home + 2, enemy);
+  }
+  if (to == home - 2)
+  {
+    return (castling_ & (side_ == 0 ? 2 : 8)) && !(occupied & (bit(home - 1) | bit(home - 2) | bit(home - 3)))
+        && !attacked(home - 1, enemy) && !attacked(home - 2, enemy);
+  }
+  return false;
+}
+
+bool finaev::ChessBoard::attacked(int square, int by) const
+{
+  const bitboard* enemy = pieces_[by];
+  bitboard occupied = colors_[0] | colors_[1];
+  return (tables().pawn[1 - by][square] & enemy[PAWN])
+      || (tables().knight[square] & enemy[KNIGHT])
+      || (tables().king[square] & enemy[KING])
+      || (sliderAttacks(bishopDirections, square, occupied) & (enemy[BISHOP] | enemy[QUEEN]))
+      || (sliderAttacks(rookDirections, square, occupied) & (enemy[ROOK] | enemy[QUEEN]));
+}
+
+void finaev::ChessBoard::apply(Piece piece, int from, int to)
+{
+  int enemy = 1 - side_;
+  Piece captured = pieceAt(enemy, to);
+  if (captured != NONE)
+  {
+    pieces_[enemy][captured] ^= bit(to);
+    colors_[enemy] ^= bit(to);
+  }
+  else if (piece == PAWN && to == enPassant_)
+  {
+    int victim = to + (side_ == 0 ? -8 : 8);
+    pieces_[enemy][PAWN] ^= bit(victim);
+    colors_[enemy] ^= bit(victim);
+  }
+  pieces_[side_][piece] ^= bit(from) | bit(to);
+  colors_[side_] ^= bit(from) | bit(to);
+  if (piece == PAWN && (to / 8 == 0 || to / 8 == 7))
+  {
+    pieces_[side_][PAWN] ^= bit(to);
+    pieces_[side_][QUEEN] ^= bit(to);
+  }
+  if (piece == KING && (to - from == 2 || from - to == 2))
+  {
+    bitboard rook = to > from ? bit(from + 3) | bit(from + 1) : bit(from - 4) | bit(from - 1);
+    pieces_[side_][ROOK] ^= rook;
+    colors_[side_] ^= rook;
+  }
+  enPassant_ = (piece == PAWN && (to - from == 16 || from - to == 16)) ? (from + to) / 2 : -1;
+  castling_ &= castlingKept(from) & castlingKept(to);
+  side_ = enemy;
+}
+
+bool finaev::isLegalLine(const DebutMoves& moves)
+{
+  ChessBoard board;
+  return std::all_of(moves.moves.begin(), moves.moves.end(), MovePlayer{ board });
+}
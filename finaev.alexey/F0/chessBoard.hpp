@@ -0,0 +1,42 @@
+#ifndef CHESSBOARD_HPP
+#define CHESSBOARD_HPP
+#include <cstdint>
+#include <string>
+#include "openningInfo.hpp"
+
+namespace finaev
+{
+  class ChessBoard
+  {
+  public:
+    ChessBoard();
+    bool play(const std::string& move);
+  private:
+    enum Piece
+    {
+      PAWN,
+      KNIGHT,
+      BISHOP,
+      ROOK,
+      QUEEN,
+      KING,
+      NONE
+    };
+
+    std::uint64_t pieces_[2][6];
+    std::uint64_t colors_[2];
+    int side_;
+    int castling_;
+    int enPassant_;
+
+    Piece pieceAt(int color, int square) const;
+    bool canReach(Piece piece, int from, int to) const;
+    bool canCastle(int from, int to) const;
+    bool attacked(int square, int by) const;
+    void apply(Piece piece, int from, int to);
+  };
+
+  bool isLegalLine(const DebutMoves& moves);
+}
+
+#endif
@@ -5,6 +5,9 @@
 #include <random>
 #include <fstream>
 #include <iterator>
+#include <memory>
+#include <thread>
+#include "chessBoard.hpp"
 
 namespace
 {
@@ -61,35 +64,28 @@ namespace
     }
   };
 
-  bool isExactMoves(const finaev::DebutMoves& f, const finaev::DebutMoves& s)
+  struct InBase
   {
-    return f.moves == s.moves;
-  }
-
-  struct СompareMoves
-  {
-    const finaev::DebutMoves& mov;
-    const finaev::globalDebuts& globalOpenings;
+    const std::unordered_map< std::string, bool >& base;
 
-    bool operator()(const std::pair< std::string, bool >& base)
+    bool operator()(const std::string& key) const
     {
-      auto it = globalOpenings.find(base.first);
-      return it != globalOpenings.end() && isExactMoves(it->second.moves, mov);
+      return base.find(key) != base.end();
     }
   };
 
   struct ResultCollectorForFind
   {
     const finaev::globalDebuts& debuts;
+    const std::unordered_map< std::string, bool >& base;
     std::vector< std::pair< std::string, std::string > >& results;
-    const finaev::DebutMoves& mov;
 
-    void operator()(const std::pair< std::string, bool >& baseEntry) const
+    void operator()(const std::string& key) const
     {
-      auto debut = debuts.find(baseEntry.first);
-      if (debut != debuts.end() && debut->second.moves.containsSequence(mov.moves))
+      auto debut = debuts.find(key);
+      if (debut != debuts.end() && base.find(key) != base.end())
       {
-        results.emplace_back(baseEntry.first, debut->second.name);
+        results.emplace_back(key, debut->second.name);
       }
     }
   };
@@ -227,44 +223,72 @@ namespace
     }
   };
 
-  struct IsChessSquare
+  struct LineLegal
   {
-    bool operator()(const std::string& sq) const
+    char operator()(const finaev::globalDebuts::value_type* debut) const
     {
-      if (sq.length() != 2)
-      {
-        return false;
-      }
-      char file = tolower(sq[0]);
-      char rank = sq[1];
-      return file >= 'a' && file <= 'h' && rank >= '1' && rank <= '8';
+      return finaev::isLegalLine(debut->second.moves);
+    }
+  };
+
+  struct LineValidator
+  {
+    const std::vector< const finaev::globalDebuts::value_type* >& debuts;
+    std::vector< char >& legal;
+    size_t begin;
+    size_t end;
+
+    void operator()() const
+    {
+      std::transform(debuts.begin() + begin, debuts.begin() + end, legal.begin() + begin, LineLegal{});
+    }
+  };
+
+  struct ValidatorThread
+  {
+    const std::vector< const finaev::globalDebuts::value_type* >& debuts;
+    std::vector< char >& legal;
+    size_t nThreads;
+    size_t index = 1;
+
+    std::thread operator()()
+    {
+      size_t begin = debuts.size() * index / nThreads;
+      size_t end = debuts.size() * ++index / nThreads;
+      return std::thread(LineValidator{ debuts, legal, begin, end });
     }
   };
 
-  struct IsChessMove
+  struct UncorrectPrint
   {
-    IsChessSquare squareValid;
+    std::ostream& out;
+    const std::vector< char >& legal;
+    size_t& uncorrect;
+    size_t index = 0;
 
-    bool operator()(const std::string& move) const
+    void operator()(const finaev::globalDebuts::value_type* debut)
     {
-      if (move.length() != 5 || move[2] != '-')
+      if (!legal[index++])
       {
-        return false;
+        out << debut->first << " - uncorrect\n";
+        ++uncorrect;
       }
-      std::string from = move.substr(0, 2);
-      std::string to = move.substr(3, 2);
-      return squareValid(from) && squareValid(to);
     }
   };
 
-  struct IsAllMovesValid
+  struct DebutPointer
   {
-    IsChessMove moveValid;
-    bool& allValid;
+    const finaev::globalDebuts::value_type* operator()(const finaev::globalDebuts::value_type& debut) const
+    {
+      return std::addressof(debut);
+    }
+  };
 
-    void operator()(const finaev::DebutMoves& moves)
+  struct KeyLess
+  {
+    bool operator()(const finaev::globalDebuts::value_type* a, const finaev::globalDebuts::value_type* b) const
     {
-      allValid = (std::all_of(moves.moves.begin(), moves.moves.end(), moveValid));
+      return a->first < b->first;
     }
   };
 
@@ -314,7 +338,7 @@ void finaev::loadDebutsFromFile(const std::string& filename, globalDebuts& debut
   std::for_each(lines.begin(), lines.end(), std::ref(processor));
 }
 
-void finaev::create_debut(std::istream& in, std::ostream& out, globalDebuts& debuts)
+void finaev::create_debut(std::istream& in, std::ostream& out, globalDebuts& debuts, DebutIndex& index)
 {
   std::string key;
   if (!(in >> key))
@@ -339,6 +363,7 @@ void finaev::create_debut(std::istream& in, std::ostream& out, globalDebuts& deb
   in >> DelimiterIO{'"'};
   std::getline(in, inf.description, '"');
   debuts[key] = inf;
+  index.insert(key, inf.moves);
   out << "Openning " << key << " successfully added";
 }
 
@@ -393,7 +418,8 @@ void finaev::add(std::istream& in, std::ostream& out, const globalDebuts& debuts
   out << "Debut " << debut <<  " successfully added in base " << baseName;
 }
 
-void finaev::exact_find(std::istream& in, std::ostream& out, const globalDebuts& debuts, const debutsBases& bases)
+void finaev::exact_find(std::istream& in, std::ostream& out, const globalDebuts& debuts, const debutsBases& bases,
+  const DebutIndex& index)
 {
   std::string baseName;
   if (!(in >> baseName))
@@ -413,12 +439,12 @@ void finaev::exact_find(std::istream& in, std::ostream& out, const globalDebuts&
     throw std::runtime_error("<NO_DEBUT_BASE>");
   }
   const auto& base = bases.at(baseName);
-  СompareMoves pred{ mov, debuts };
-  auto found = std::find_if(base.begin(), base.end(), pred);
-  if (found != base.end())
+  std::vector< std::string > exactKeys = index.exact(mov);
+  auto found = std::find_if(exactKeys.begin(), exactKeys.end(), InBase{ base });
+  if (found != exactKeys.end())
   {
-    const auto& opening = debuts.at(found->first);
-    out << "Key: " << found->first << "\n";
+    const auto& opening = debuts.at(*found);
+    out << "Key: " << *found << "\n";
     out << "Name: " << opening.name;
   }
   else
@@ -427,7 +453,8 @@ void finaev::exact_find(std::istream& in, std::ostream& out, const globalDebuts&
   }
 }
 
-void finaev::find(std::istream& in, std::ostream& out, const globalDebuts& debuts, const debutsBases& bases)
+void finaev::find(std::istream& in, std::ostream& out, const globalDebuts& debuts, const debutsBases& bases,
+  DebutIndex& index)
 {
   std::string baseName;
   if (!(in >> baseName))
@@ -448,8 +475,9 @@ void finaev::find(std::istream& in, std::ostream& out, const globalDebuts& debut
   }
   auto base = bases.find(baseName);
   std::vector< std::pair< std::string, std::string > > foundOpenings;
-  ResultCollectorForFind collector{ debuts, foundOpenings, mov};
-  std::for_each(base->second.begin(), base->second.end(), collector);
+  std::vector< std::string > containingKeys = index.containing(mov);
+  ResultCollectorForFind collector{ debuts, base->second, foundOpenings };
+  std::for_each(containingKeys.begin(), containingKeys.end(), collector);
   std::sort(foundOpenings.begin(), foundOpenings.end(), KeySorterForFind());
   if (foundOpenings.empty())
   {
@@ -648,7 +676,8 @@ void finaev::remove(std::istream& in, std::ostream& out, const globalDebuts& deb
   out << "Debut " << key << " removed from base " << baseName;
 }
 
-void finaev::force_delete(std::istream& in, std::ostream& out, globalDebuts& debuts, debutsBases& bases)
+void finaev::force_delete(std::istream& in, std::ostream& out, globalDebuts& debuts, debutsBases& bases,
+  DebutIndex& index)
 {
   std::string key, temp;
   if (!(in >> key))
@@ -667,10 +696,12 @@ void finaev::force_delete(std::istream& in, std::ostream& out, globalDebuts& deb
   RemoveDebut remover{ key };
   std::for_each(bases.begin(), bases.end(), remover);
   debuts.erase(key);
+  index.erase(key);
   out << "Debut " << key << " completely deleted from system debuts";
 }
 
-void finaev::safe_delete(std::istream& in, std::ostream& out, globalDebuts& debuts, const debutsBases& bases)
+void finaev::safe_delete(std::istream& in, std::ostream& out, globalDebuts& debuts, const debutsBases& bases,
+  DebutIndex& index)
 {
   std::string key, temp;
   if (!(in >> key))
@@ -695,10 +726,12 @@ void finaev::safe_delete(std::istream& in, std::ostream& out, globalDebuts& debu
     return;
   }
   debuts.erase(key);
+  index.erase(key);
   out << "Debut " << key << " safely deleted from system";
 }
 
-void finaev::delete_debut(std::istream& in, std::ostream& out, globalDebuts& debuts, debutsBases& bases)
+void finaev::delete_debut(std::istream& in, std::ostream& out, globalDebuts& debuts, debutsBases& bases,
+  DebutIndex& index)
 {
   std::string key, temp;
   if (!(in >> key))
@@ -731,6 +764,7 @@ void finaev::delete_debut(std::istream& in, std::ostream& out, globalDebuts& deb
     std::for_each(bases.begin(), bases.end(), remover);
   }
   debuts.erase(debut);
+  index.erase(key);
   out << "Debut " << key << (count > 0 ? " completely deleted from system debuts" : " safely deleted from system");
 }
 
@@ -751,14 +785,35 @@ void finaev::validate(std::istream& in, std::ostream& out, const globalDebuts& d
   {
     throw std::runtime_error("<OPENNING_NOT_FOUND>");
   }
-  IsChessSquare squareValid;
-  IsChessMove moveValid{ squareValid };
-  bool isValidate = false;
-  IsAllMovesValid validator{ moveValid, isValidate };
-  validator(debut->second.moves);
+  bool isValidate = isLegalLine(debut->second.moves);
   out << key << (isValidate ? " - ok" : " - uncorrect");
 }
 
+void finaev::validate_all(std::istream& in, std::ostream& out, const globalDebuts& debuts)
+{
+  std::string temp;
+  std::getline(in, temp);
+  if (!temp.empty())
+  {
+    throw std::runtime_error("<INVALID COMMAND>");
+  }
+  std::vector< const globalDebuts::value_type* > lines;
+  lines.reserve(debuts.size());
+  std::transform(debuts.begin(), debuts.end(), std::back_inserter(lines), DebutPointer{});
+  std::sort(lines.begin(), lines.end(), KeyLess{});
+  std::vector< char > legal(lines.size());
+  size_t nThreads = std::max(1u, std::thread::hardware_concurrency());
+  nThreads = std::max< size_t >(1, std::min(nThreads, lines.size()));
+  std::vector< std::thread > threads;
+  threads.reserve(nThreads - 1);
+  std::generate_n(std::back_inserter(threads), nThreads - 1, ValidatorThread{ lines, legal, nThreads });
+  LineValidator{ lines, legal, 0, lines.size() / nThreads }();
+  std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+  size_t uncorrect = 0;
+  std::for_each(lines.begin(), lines.end(), UncorrectPrint{ out, legal, uncorrect });
+  out << "Validated " << lines.size() << " debuts, " << uncorrect << " uncorrect";
+}
+
 void finaev::guess(std::istream& in, std::ostream& out, const globalDebuts& debuts, const debutsBases& bases)
 {
   std::string baseName, temp;
@@ -813,24 +868,26 @@ void finaev::guess(std::istream& in, std::ostream& out, const globalDebuts& debu
   }
 }
 
-finaev::mapOfCommands finaev::createCommandsHandler(std::istream& in, std::ostream& out, globalDebuts& debuts, debutsBases& bases)
+finaev::mapOfCommands finaev::createCommandsHandler(std::istream& in, std::ostream& out, globalDebuts& debuts, debutsBases& bases,
+  DebutIndex& index)
 {
   mapOfCommands commands;
-  commands["create_debut"] = std::bind(finaev::create_debut, std::ref(in), std::ref(out), std::ref(debuts));
+  commands["create_debut"] = std::bind(finaev::create_debut, std::ref(in), std::ref(out), std::ref(debuts), std::ref(index));
   commands["create_base"] = std::bind(finaev::create_base, std::ref(in), std::ref(out), std::ref(bases));
   commands["add"] = std::bind(finaev::add, std::ref(in), std::ref(out), std::cref(debuts), std::ref(bases));
-  commands["exact_find"] = std::bind(finaev::exact_find, std::ref(in), std::ref(out), std::cref(debuts), std::cref(bases));
-  commands["find"] = std::bind(finaev::find, std::ref(in), std::ref(out), std::cref(debuts), std::cref(bases));
+  commands["exact_find"] = std::bind(finaev::exact_find, std::ref(in), std::ref(out), std::cref(debuts), std::cref(bases), std::cref(index));
+  commands["find"] = std::bind(finaev::find, std::ref(in), std::ref(out), std::cref(debuts), std::cref(bases), std::ref(index));
   commands["print"] = std::bind(finaev::print, std::ref(in), std::ref(out), std::cref(debuts), std::cref(bases));
   commands["move"] = std::bind(finaev::move, std::ref(in), std::ref(out), std::cref(debuts), std::ref(bases));
   commands["merge"] = std::bind(finaev::merge, std::ref(in), std::ref(out), std::cref(debuts), std::ref(bases));
   commands["intersect"] = std::bind(finaev::intersect, std::ref(in), std::ref(out), std::cref(debuts), std::ref(bases));
   commands["complement"] = std::bind(finaev::complement, std::ref(in), std::ref(out), std::cref(debuts), std::ref(bases));
   commands["remove"] = std::bind(finaev::remove, std::ref(in), std::ref(out), std::cref(debuts), std::ref(bases));
-  commands["force_delete"] = std::bind(finaev::force_delete, std::ref(in), std::ref(out), std::ref(debuts), std::ref(bases));
-  commands["safe_delete"] = std::bind(finaev::safe_delete, std::ref(in), std::ref(out), std::ref(debuts), std::cref(bases));
-  commands["delete"] = std::bind(finaev::delete_debut, std::ref(in), std::ref(out), std::ref(debuts), std::ref(bases));
+  commands["force_delete"] = std::bind(finaev::force_delete, std::ref(in), std::ref(out), std::ref(debuts), std::ref(bases), std::ref(index));
+  commands["safe_delete"] = std::bind(finaev::safe_delete, std::ref(in), std::ref(out), std::ref(debuts), std::cref(bases), std::ref(index));
+  commands["delete"] = std::bind(finaev::delete_debut, std::ref(in), std::ref(out), std::ref(debuts), std::ref(bases), std::ref(index));
   commands["validate"] = std::bind(finaev::validate, std::ref(in), std::ref(out), std::cref(debuts));
+  commands["validate_all"] = std::bind(finaev::validate_all, std::ref(in), std::ref(out), std::cref(debuts));
   commands["guess"] = std::bind(finaev::guess, std::ref(in), std::ref(out), std::cref(debuts), std::cref(bases));
   return commands;
 }
@@ -6,6 +6,7 @@
 #include <functional>
 #include <algorithm>
 #include "openningInfo.hpp"
+#include "debutIndex.hpp"
 
 namespace finaev
 {
@@ -15,24 +16,25 @@ namespace finaev
 
   void loadDebutsFromFile(const std::string& filename, globalDebuts& debuts, std::ostream& out);
 
-  void create_debut(std::istream&, std::ostream&, globalDebuts&);
+  void create_debut(std::istream&, std::ostream&, globalDebuts&, DebutIndex&);
   void create_base(std::istream&, std::ostream&, debutsBases&);
   void add(std::istream&, std::ostream&, const globalDebuts&, debutsBases&);
-  void exact_find(std::istream&, std::ostream&, const globalDebuts&, const debutsBases&);
-  void find(std::istream&, std::ostream&, const globalDebuts&, const debutsBases&);
+  void exact_find(std::istream&, std::ostream&, const globalDebuts&, const debutsBases&, const DebutIndex&);
+  void find(std::istream&, std::ostream&, const globalDebuts&, const debutsBases&, DebutIndex&);
   void print(std::istream&, std::ostream&, const globalDebuts&, const debutsBases&);
   void move(std::istream&, std::ostream&, const globalDebuts&, debutsBases&);
   void merge(std::istream&, std::ostream&, const globalDebuts&, debutsBases&);
   void intersect(std::istream&, std::ostream&, const globalDebuts&, debutsBases&);
   void complement(std::istream&, std::ostream&, const globalDebuts&, debutsBases&);
   void remove(std::istream&, std::ostream&, const globalDebuts&, debutsBases&);
-  void force_delete(std::istream&, std::ostream&, globalDebuts&, debutsBases&);
-  void safe_delete(std::istream&, std::ostream&, globalDebuts&, const debutsBases&);
-  void delete_debut(std::istream&, std::ostream&, globalDebuts&, debutsBases&);
+  void force_delete(std::istream&, std::ostream&, globalDebuts&, debutsBases&, DebutIndex&);
+  void safe_delete(std::istream&, std::ostream&, globalDebuts&, const debutsBases&, DebutIndex&);
+  void delete_debut(std::istream&, std::ostream&, globalDebuts&, debutsBases&, DebutIndex&);
   void validate(std::istream&, std::ostream&, const globalDebuts&);
+  void validate_all(std::istream&, std::ostream&, const globalDebuts&);
   void guess(std::istream&, std::ostream&, const globalDebuts&, const debutsBases&);
 
-  mapOfCommands createCommandsHandler(std::istream& in, std::ostream& out, globalDebuts&, debutsBases&);
+  mapOfCommands createCommandsHandler(std::istream& in, std::ostream& out, globalDebuts&, debutsBases&, DebutIndex&);
 }
 
 #endif
@@ -0,0 +1,291 @@
+#include "debutIndex.hpp"
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <limits>
+
+namespace
+{
+  using moveId = std::uint32_t;
+  constexpr moveId separatorBit = 0x80000000;
+  constexpr size_t noNode = std::numeric_limits< size_t >::max();
+
+  struct SuffixLess
+  {
+    const std::vector< moveId >& text;
+
+    bool operator()(size_t lhs, size_t rhs) const
+    {
+      return std::lexicographical_compare(text.begin() + lhs, text.end(), text.begin() + rhs, text.end());
+    }
+  };
+
+  struct PatternCompare
+  {
+    const std::vector< moveId >& text;
+
+    int compare(size_t pos, const std::vector< moveId >& pattern) const
+    {
+      auto diff = std::mismatch(pattern.begin(), pattern.end(), text.begin() + pos, text.end());
+      if (diff.first == pattern.end())
+      {
+        return 0;
+      }
+      return *diff.second < *diff.first ? -1 : 1;
+    }
+    bool operator()(size_t pos, const std::vector< moveId >& pattern) const
+    {
+      return compare(pos, pattern) < 0;
+    }
+    bool operator()(const std::vector< moveId >& pattern, size_t pos) const
+    {
+      return compare(pos, pattern) > 0;
+    }
+  };
+
+  struct IsSeparator
+  {
+    bool operator()(moveId id) const
+    {
+      return id & separatorBit;
+    }
+  };
+
+  struct SuffixOwner
+  {
+    const std::vector< moveId >& text;
+
+    size_t operator()(size_t pos) const
+    {
+      return *std::find_if(text.begin() + pos, text.end(), IsSeparator{}) & ~separatorBit;
+    }
+  };
+
+  struct ChildIs
+  {
+    moveId move;
+
+    bool operator()(const std::pair< moveId, size_t >& child) const
+    {
+      return child.first == move;
+    }
+  };
+
+  struct MoveRegistrar
+  {
+    std::unordered_map< std::string, moveId >& ids;
+
+    moveId operator()(const std::string& move) const
+    {
+      return ids.emplace(move, static_cast< moveId >(ids.size())).first->second;
+    }
+  };
+
+  struct MoveLookup
+  {
+    const std::unordered_map< std::string, moveId >& ids;
+
+    moveId operator()(const std::string& move) const
+    {
+      auto id = ids.find(move);
+      return id == ids.end() ? separatorBit : id->second;
+    }
+  };
+
+  template< class Node >
+  struct TrieGrow
+  {
+    std::vector< Node >& trie;
+
+    size_t operator()(size_t node, moveId move) const
+    {
+      auto& children = trie[node].children;
+      auto child = std::find_if(children.begin(), children.end(), ChildIs{ move });
+      if (child != children.end())
+      {
+        return child->second;
+      }
+      children.emplace_back(move, trie.size());
+      trie.emplace_back();
+      return trie.size() - 1;
+    }
+  };
+
+  template< class Node >
+  struct TrieDescend
+  {
+    const std::vector< Node >& trie;
+
+    size_t operator()(size_t node, moveId move) const
+    {
+      if (node == noNode)
+      {
+        return noNode;
+      }
+      const auto& children = trie[node].children;
+      auto child = std::find_if(children.begin(), children.end(), ChildIs{ move });
+      return child == children.end() ? noNode : child->second;
+    }
+  };
+
+  template< class Debut >
+  struct DebutKey
+  {
+    const std::vector< Debut >& debuts;
+
+    const std::string& operator()(size_t i) const
+    {
+      return debuts[i].key;
+    }
+  };
+
+  template< class Debut >
+  struct DebutDead
+  {
+    const std::vector< Debut >& debuts;
+
+    bool operator()(size_t i) const
+    {
+      return !debuts[i].alive;
+    }
+  };
+
+  template< class Debut >
+  struct DebutContains
+  {
+    const std::vector< Debut >& debuts;
+    const std::vector< moveId >& pattern;
+
+    bool operator()(size_t i) const
+    {
+      const auto& moves = debuts[i].moves;
+      return std::search(moves.begin(), moves.end(), pattern.begin(), pattern.end()) != moves.end();
+    }
+  };
+
+  template< class Debut, class Position >
+  struct TextAppender
+  {
+    std::vector< moveId >& text;
+    std::vector< Position >& suffixes;
+    moveId owner;
+
+    void operator()(const Debut& debut)
+    {
+      if (debut.alive)
+      {
+        size_t first = suffixes.size();
+        suffixes.resize(first + debut.moves.size());
+        std::iota(suffixes.begin() + first, suffixes.end(), static_cast< Position >(text.size()));
+        text.insert(text.end(), debut.moves.begin(), debut.moves.end());
+        text.push_back(separatorBit | owner);
+      }
+      ++owner;
+    }
+  };
+
+  struct DebutInserter
+  {
+    finaev::DebutIndex& index;
+
+    void operator()(const std::pair< const std::string, finaev::OpenningInfo >& debut) const
+    {
+      index.insert(debut.first, debut.second.moves);
+    }
+  };
+}
+
+finaev::DebutIndex::DebutIndex(const std::unordered_map< std::string, OpenningInfo >& debuts)
+{
+  std::for_each(debuts.begin(), debuts.end(), DebutInserter{ *this });
+}
+
+void finaev::DebutIndex::insert(const std::string& key, const DebutMoves& moves)
+{
+  erase(key);
+  Debut debut{ key, {}, 0, true };
+  debut.moves.reserve(moves.moves.size());
+  std::transform(moves.moves.begin(), moves.moves.end(), std::back_inserter(debut.moves), MoveRegistrar{ moveIds_ });
+  debut.node = std::accumulate(debut.moves.begin(), debut.moves.end(), size_t(0), TrieGrow< TrieNode >{ trie_ });
+  trie_[debut.node].debuts.push_back(debuts_.size());
+  keys_[key] = debuts_.size();
+  pending_.push_back(debuts_.size());
+  staleMoves_ += debut.moves.size();
+  debuts_.push_back(std::move(debut));
+}
+
+void finaev::DebutIndex::erase(const std::string& key)
+{
+  auto found = keys_.find(key);
+  if (found == keys_.end())
+  {
+    return;
+  }
+  Debut& debut = debuts_[found->second];
+  auto& atNode = trie_[debut.node].debuts;
+  atNode.erase(std::find(atNode.begin(), atNode.end(), found->second));
+  staleMoves_ += debut.moves.size();
+  debut.alive = false;
+  debut.moves = std::vector< moveId >();
+  keys_.erase(found);
+}
+
+std::vector< std::string > finaev::DebutIndex::exact(const DebutMoves& moves) const
+{
+  std::vector< std::string > result;
+  std::vector< moveId > ids;
+  if (!translate(moves, ids))
+  {
+    return result;
+  }
+  size_t node = std::accumulate(ids.begin(), ids.end(), size_t(0), TrieDescend< TrieNode >{ trie_ });
+  if (node == noNode)
+  {
+    return result;
+  }
+  const std::vector< size_t >& atNode = trie_[node].debuts;
+  std::transform(atNode.begin(), atNode.end(), std::back_inserter(result), DebutKey< Debut >{ debuts_ });
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::vector< std::string > finaev::DebutIndex::containing(const DebutMoves& moves)
+{
+  std::vector< std::string > result;
+  std::vector< moveId > pattern;
+  if (moves.moves.empty() || !translate(moves, pattern))
+  {
+    return result;
+  }
+  if (staleMoves_ > indexedMoves_ / 4)
+  {
+    rebuild();
+  }
+  std::vector< size_t > found;
+  auto range = std::equal_range(suffixes_.begin(), suffixes_.end(), pattern, PatternCompare{ text_ });
+  std::transform(range.first, range.second, std::back_inserter(found), SuffixOwner{ text_ });
+  std::copy_if(pending_.begin(), pending_.end(), std::back_inserter(found), DebutContains< Debut >{ debuts_, pattern });
+  std::sort(found.begin(), found.end());
+  found.erase(std::unique(found.begin(), found.end()), found.end());
+  found.erase(std::remove_if(found.begin(), found.end(), DebutDead< Debut >{ debuts_ }), found.end());
+  std::transform(found.begin(), found.end(), std::back_inserter(result), DebutKey< Debut >{ debuts_ });
+  return result;
+}
+
+bool finaev::DebutIndex::translate(const DebutMoves& moves, std::vector< moveId >& ids) const
+{
+  ids.reserve(moves.moves.size());
+  std::transform(moves.moves.begin(), moves.moves.end(), std::back_inserter(ids), MoveLookup{ moveIds_ });
+  return std::find_if(ids.begin(), ids.end(), IsSeparator{}) == ids.end();
+}
+
+void finaev::DebutIndex::rebuild()
+{
+  text_.clear();
+  suffixes_.clear();
+  std::for_each(debuts_.begin(), debuts_.end(), TextAppender< Debut, position >{ text_, suffixes_, 0 });
+  std::sort(suffixes_.begin(), suffixes_.end(), SuffixLess{ text_ });
+  indexedMoves_ = suffixes_.size();
+  staleMoves_ = 0;
+  pending_.clear();
+}
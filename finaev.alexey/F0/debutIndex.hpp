@@ -0,0 +1,54 @@
+#ifndef DEBUTINDEX_HPP
+#define DEBUTINDEX_HPP
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <utility>
+#include <unordered_map>
+#include "openningInfo.hpp"
+
+namespace finaev
+{
+  class DebutIndex
+  {
+  public:
+    DebutIndex() = default;
+    explicit DebutIndex(const std::unordered_map< std::string, OpenningInfo >& debuts);
+
+    void insert(const std::string& key, const DebutMoves& moves);
+    void erase(const std::string& key);
+    std::vector< std::string > exact(const DebutMoves& moves) const;
+    std::vector< std::string > containing(const DebutMoves& moves);
+  private:
+    using moveId = std::uint32_t;
+    using position = std::uint32_t;
+    struct Debut
+    {
+      std::string key;
+      std::vector< moveId > moves;
+      size_t node;
+      bool alive;
+    };
+    struct TrieNode
+    {
+      std::vector< std::pair< moveId, size_t > > children;
+      std::vector< size_t > debuts;
+    };
+
+    std::unordered_map< std::string, moveId > moveIds_;
+    std::vector< Debut > debuts_;
+    std::unordered_map< std::string, size_t > keys_;
+    std::vector< TrieNode > trie_{1};
+    std::vector< moveId > text_;
+    std::vector< position > suffixes_;
+    std::vector< size_t > pending_;
+    size_t indexedMoves_ = 0;
+    size_t staleMoves_ = 0;
+
+    bool translate(const DebutMoves& moves, std::vector< moveId >& ids) const;
+    void rebuild();
+  };
+}
+
+#endif
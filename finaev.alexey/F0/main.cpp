@@ -4,6 +4,7 @@
 #include <limits>
 #include "commands.hpp"
 #include "openningInfo.hpp"
+#include "debutIndex.hpp"
 
 int main(int argc, char* argv[])
 {
@@ -36,7 +37,8 @@ int main(int argc, char* argv[])
       return 1;
     }
   }
-  auto commands = finaev::createCommandsHandler(std::cin, std::cout, globalOpenings, bases);
+  finaev::DebutIndex index(globalOpenings);
+  auto commands = finaev::createCommandsHandler(std::cin, std::cout, globalOpenings, bases, index);
   std::string cmd;
   while (std::cin >> cmd)
   {
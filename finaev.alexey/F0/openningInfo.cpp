@@ -1,7 +1,6 @@
 #include "openningInfo.hpp"
 #include <delimiter.hpp>
 #include <iterator>
-#include <algorithm>
 #include <iostream>
 #include <numeric>
 
@@ -70,13 +69,3 @@ std::istream& finaev::operator>>(std::istream& in, DebutMoves& m)
   }
   return in;
 }
-
-bool finaev::DebutMoves::containsSequence(const std::vector< std::string >& sequence) const
-{
-  if (sequence.empty())
-  {
-    return false;
-  }
-  auto it = std::search( moves.begin(), moves.end(), sequence.begin(), sequence.end());
-  return it != moves.end();
-}
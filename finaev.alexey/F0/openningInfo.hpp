@@ -8,7 +8,6 @@ namespace finaev
   struct DebutMoves
   {
     std::vector< std::string > moves;
-    bool containsSequence(const std::vector< std::string >& sequence) const;
   };
 
   std::istream& operator>>(std::istream&, DebutMoves&);
@@ -21,33 +21,83 @@ struct PrefixChecker {
   }
 };
 
-struct GetFirst {
-  const std::string &operator()(const std::pair<std::string, std::string> &p) const {
-    return p.first;
+const std::size_t gramSize = 3;
+
+void collectGrams(const std::string &text, std::size_t pos, std::set<std::string> &grams)
+{
+  if (pos + gramSize > text.size()) return;
+  grams.insert(text.substr(pos, gramSize));
+  collectGrams(text, pos + 1, grams);
+}
+
+std::set<std::string> splitGrams(const std::string &text)
+{
+  std::set<std::string> grams;
+  collectGrams(text, 0, grams);
+  return grams;
+}
+
+struct GramAdder {
+  std::unordered_map<std::string, std::set<std::string>> &grams;
+  const std::string &word;
+  void operator()(const std::string &gram) const {
+    grams[gram].insert(word);
+  }
+};
+
+struct GramRemover {
+  std::unordered_map<std::string, std::set<std::string>> &grams;
+  const std::string &word;
+  void operator()(const std::string &gram) const {
+    std::unordered_map<std::string, std::set<std::string>>::iterator it = grams.find(gram);
+    if (it == grams.end()) return;
+    it->second.erase(word);
+    if (it->second.empty()) {
+      grams.erase(it);
+    }
+  }
+};
+
+struct SmallestPostings {
+  const std::unordered_map<std::string, std::set<std::string>> &grams;
+  const std::set<std::string> *best;
+  bool missing;
+  void operator()(const std::string &gram) {
+    std::unordered_map<std::string, std::set<std::string>>::const_iterator it = grams.find(gram);
+    if (it == grams.end()) {
+      missing = true;
+      return;
+    }
+    if (!best || it->second.size() < best->size()) {
+      best = &it->second;
+    }
   }
 };
 
 struct TranslationFragmentChecker {
+  const std::unordered_map<std::string, std::string> &data;
   const std::string &fragment;
-  TranslationFragmentChecker(const std::string &f) : fragment(f) {}
 
-  bool operator()(const std::pair<std::string, std::string> &entry) const {
+  bool operator()(const std::pair<const std::string, std::string> &entry) const {
     return entry.second.find(fragment) != std::string::npos;
   }
 
   bool operator()(const std::string &word) const {
-    return false;
+    return data.find(word)->second.find(fragment) != std::string::npos;
   }
 };
 
-struct KeyInRangeChecker {
-  const std::string &start;
-  const std::string &end;
-  KeyInRangeChecker(const std::string &s,
-                    const std::string &e): start(s), end(e) {}
-  bool operator()(const std::pair<std::string, std::string> &p) const
-  {
-    return p.first >= start && p.first <= end;
+struct NotPrefixChecker {
+  PrefixChecker checker;
+  bool operator()(const std::string &word) const {
+    return !checker(word);
+  }
+};
+
+struct WordInserter {
+  Dictionary &dict;
+  void operator()(const std::pair<std::string, std::string> &p) const {
+    dict.addWord(p.first, p.second);
   }
 };
 
@@ -85,24 +135,23 @@ struct SwapPair {
   }
 };
 
-struct IdentityPair {
-  const std::pair<std::string, std::string> &operator()(const std::pair<std::string, std::string> &p) const
-  {
-    return p;
-  }
-};
-
 }
 
 void Dictionary::addWord(const std::string &word,
                          const std::string &translation)
 {
-  data_.insert(std::make_pair(word, translation));
+  if (data_.insert(std::make_pair(word, translation)).second) {
+    indexWord(word, translation);
+  }
 }
 
 void Dictionary::removeWord(const std::string &word)
 {
-  data_.erase(word);
+  std::unordered_map<std::string, std::string>::iterator it = data_.find(word);
+  if (it != data_.end()) {
+    unindexWord(word, it->second);
+    data_.erase(it);
+  }
 }
 
 void Dictionary::editWord(const std::string &word,
@@ -110,7 +159,9 @@ void Dictionary::editWord(const std::string &word,
 {
   std::unordered_map<std::string, std::string>::iterator it = data_.find(word);
   if (it != data_.end()) {
+    unindexWord(word, it->second);
     it->second = newTranslation;
+    indexWord(word, newTranslation);
   }
 }
 
@@ -127,25 +178,10 @@ bool Dictionary::findWord(const std::string &word,
 
 std::vector<std::string> Dictionary::listWordsWithPrefix(const std::string &prefix) const
 {
-  std::vector<std::string> result;
-  PrefixChecker checker(prefix);
-
-  std::vector<std::pair<std::string, std::string>> allWords = getAllWords();
-
-  result.reserve(allWords.size());
-  std::transform(allWords.begin(), allWords.end(), std::back_inserter(result), GetFirst());
-
-  struct NotPrefixChecker {
-    const PrefixChecker &checker;
-    NotPrefixChecker(const PrefixChecker &c) : checker(c) {}
-    bool operator()(const std::string &word) const {
-      return !checker(word);
-    }
-  };
-
-  result.erase(std::remove_if(result.begin(), result.end(), NotPrefixChecker(checker)), result.end());
-
-  return result;
+  std::set<std::string>::const_iterator first = words_.lower_bound(prefix);
+  std::set<std::string>::const_iterator last = std::find_if(first, words_.end(),
+                                                            NotPrefixChecker{PrefixChecker(prefix)});
+  return std::vector<std::string>(first, last);
 }
 
 std::vector<std::pair<std::string, std::string>> Dictionary::getAllWords() const
@@ -161,6 +197,8 @@ std::size_t Dictionary::getWordCount() const
 void Dictionary::clear()
 {
   data_.clear();
+  words_.clear();
+  grams_.clear();
 }
 
 const std::unordered_map<std::string, std::string> &Dictionary::getData() const
@@ -170,10 +208,7 @@ const std::unordered_map<std::string, std::string> &Dictionary::getData() const
 
 void Dictionary::mergeFrom(const Dictionary &other)
 {
-  std::vector<std::pair<std::string, std::string>> buffer(other.data_.begin(), other.data_.end());
-  std::transform(buffer.begin(), buffer.end(), buffer.begin(), IdentityPair());
-  std::copy(buffer.begin(), buffer.end(),
-            std::inserter(data_, data_.end()));
+  std::for_each(other.data_.begin(), other.data_.end(), WordInserter{*this});
 }
 
 Dictionary Dictionary::intersectWith(const Dictionary &other) const
@@ -182,8 +217,7 @@ Dictionary Dictionary::intersectWith(const Dictionary &other) const
   KeyExistsInOther checker(other);
   std::vector<std::pair<std::string, std::string>> temp;
   std::copy_if(data_.begin(), data_.end(), std::back_inserter(temp), checker);
-  std::copy(temp.begin(), temp.end(),
-            std::inserter(result.data_, result.data_.end()));
+  std::for_each(temp.begin(), temp.end(), WordInserter{result});
   return result;
 }
 
@@ -193,48 +227,50 @@ Dictionary Dictionary::diffFrom(const Dictionary &other) const
   NotInOtherChecker checker(other);
   std::vector<std::pair<std::string, std::string>> temp;
   std::copy_if(data_.begin(), data_.end(), std::back_inserter(temp), checker);
-  std::copy(temp.begin(), temp.end(),
-            std::inserter(result.data_, result.data_.end()));
+  std::for_each(temp.begin(), temp.end(), WordInserter{result});
   return result;
 }
 
 Dictionary Dictionary::extractRange(const std::string &start, const std::string &end) const
 {
   Dictionary result;
-  KeyInRangeChecker checker(start, end);
-  std::vector<std::pair<std::string, std::string>> temp;
-  std::copy_if(data_.begin(), data_.end(), std::back_inserter(temp), checker);
-  std::copy(temp.begin(), temp.end(),
-            std::inserter(result.data_, result.data_.end()));
+  if (end < start) {
+    return result;
+  }
+  std::set<std::string>::const_iterator first = words_.lower_bound(start);
+  std::set<std::string>::const_iterator last = words_.upper_bound(end);
+
+  struct RangeInserter {
+    const std::unordered_map<std::string, std::string> &data;
+    Dictionary &dict;
+    void operator()(const std::string &word) const {
+      dict.addWord(word, data.find(word)->second);
+    }
+  };
+
+  std::for_each(first, last, RangeInserter{data_, result});
   return result;
 }
 
 std::vector<std::string> Dictionary::getWordsByTranslationFragment(const std::string &fragment) const
 {
-  std::vector<std::pair<std::string, std::string>> allWords = getAllWords();
-  TranslationFragmentChecker checker(fragment);
-
-  struct CheckAndKeepFirst {
-    const TranslationFragmentChecker &checker;
-    explicit CheckAndKeepFirst(const TranslationFragmentChecker &chk) : checker(chk) {}
-
-    bool operator()(const std::pair<std::string, std::string> &entry) const {
-      return checker(entry);
-    }
-  };
-
-  struct ExtractFirst {
-    std::string operator()(const std::pair<std::string, std::string> &entry) const {
-      return entry.first;
-    }
-  };
-
-  std::vector<std::pair<std::string, std::string>> filtered;
-  std::copy_if(allWords.begin(), allWords.end(), std::back_inserter(filtered), CheckAndKeepFirst(checker));
-
+  TranslationFragmentChecker checker{data_, fragment};
   std::vector<std::string> result;
-  std::transform(filtered.begin(), filtered.end(), std::back_inserter(result), ExtractFirst());
 
+  if (fragment.size() < gramSize) {
+    std::vector<std::pair<std::string, std::string>> filtered;
+    std::copy_if(data_.begin(), data_.end(), std::back_inserter(filtered), checker);
+    std::transform(filtered.begin(), filtered.end(), std::back_inserter(result), KeyExtractor());
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  std::set<std::string> grams = splitGrams(fragment);
+  SmallestPostings smallest = std::for_each(grams.begin(), grams.end(), SmallestPostings{grams_, nullptr, false});
+  if (smallest.missing) {
+    return result;
+  }
+  std::copy_if(smallest.best->begin(), smallest.best->end(), std::back_inserter(result), checker);
   return result;
 }
 
@@ -254,7 +290,20 @@ void Dictionary::swapTranslations()
   std::vector<std::pair<std::string, std::string>> temp;
   std::transform(data_.begin(), data_.end(),
                  std::back_inserter(temp), SwapPair());
-  data_.clear();
-  std::copy(temp.begin(), temp.end(),
-            std::inserter(data_, data_.end()));
+  clear();
+  std::for_each(temp.begin(), temp.end(), WordInserter{*this});
+}
+
+void Dictionary::indexWord(const std::string &word, const std::string &translation)
+{
+  words_.insert(word);
+  std::set<std::string> grams = splitGrams(translation);
+  std::for_each(grams.begin(), grams.end(), GramAdder{grams_, word});
+}
+
+void Dictionary::unindexWord(const std::string &word, const std::string &translation)
+{
+  words_.erase(word);
+  std::set<std::string> grams = splitGrams(translation);
+  std::for_each(grams.begin(), grams.end(), GramRemover{grams_, word});
 }
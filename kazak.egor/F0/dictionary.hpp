@@ -2,6 +2,7 @@
 #define DICTIONARY_HPP
 
 #include <string>
+#include <set>
 #include <unordered_map>
 #include <vector>
 #include <utility>
@@ -27,7 +28,12 @@ public:
   void swapTranslations();
 
 private:
+  void indexWord(const std::string &word, const std::string &translation);
+  void unindexWord(const std::string &word, const std::string &translation);
+
   std::unordered_map<std::string, std::string> data_;
+  std::set<std::string> words_;
+  std::unordered_map<std::string, std::set<std::string>> grams_;
 };
 
 #endif
@@ -1,8 +1,12 @@
 #include "commands.h"
 #include <cctype>
 #include <fstream>
+#include <future>
 #include <iterator>
+#include <limits>
 #include <numeric>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 namespace
@@ -71,14 +75,6 @@ namespace
     }
   };
 
-  struct PairSorter
-  {
-    bool operator()(const std::pair<std::string, std::string>& a, const std::pair<std::string, std::string>& b) const
-    {
-      return a.first < b.first;
-    }
-  };
-
   struct KeyExtractor
   {
     std::string operator()(const std::pair<std::string, dictionary>& item) const
@@ -121,32 +117,166 @@ namespace
     }
   };
 
-  struct ResultsCollector
+  using SearchResult = std::pair<std::string, std::pair<std::string, std::string>>;
+  using SearchResults = std::vector<SearchResult>;
+
+  const size_t minEntriesPerTask = 4096;
+
+  struct MatchCollector
+  {
+    const std::string& dictId;
+    const PatternMatcher& matcher;
+    size_t limit;
+    SearchResults& results;
+
+    bool operator()(const std::pair<const std::string, std::string>& entry) const
+    {
+      if (matcher(entry))
+      {
+        results.emplace_back(dictId, entry);
+      }
+      return results.size() >= limit;
+    }
+  };
+
+  struct DictCollector
+  {
+    const PatternMatcher& matcher;
+    size_t limit;
+    SearchResults& results;
+
+    bool operator()(const dictionaries::value_type& dictPair) const
+    {
+      MatchCollector collector{ dictPair.first, matcher, limit, results };
+      std::find_if(dictPair.second.begin(), dictPair.second.end(), collector);
+      return results.size() >= limit;
+    }
+  };
+
+  SearchResults searchEntries(const std::string& dictId, dictionary::const_iterator first,
+    dictionary::const_iterator last, const std::string& pattern, size_t limit)
+  {
+    SearchResults results;
+    PatternMatcher matcher{ pattern };
+    std::find_if(first, last, MatchCollector{ dictId, matcher, limit, results });
+    return results;
+  }
+
+  SearchResults searchDicts(dictionaries::const_iterator first, dictionaries::const_iterator last,
+    const std::string& pattern, size_t limit)
+  {
+    SearchResults results;
+    PatternMatcher matcher{ pattern };
+    std::find_if(first, last, DictCollector{ matcher, limit, results });
+    return results;
+  }
+
+  size_t countTasks(size_t items, size_t minItemsPerTask)
+  {
+    size_t workers = std::max(std::thread::hardware_concurrency(), 1u);
+    return std::max(std::min(workers, items / minItemsPerTask), size_t(1));
+  }
+
+  template< class It >
+  void splitRange(It first, size_t size, size_t parts, std::vector<std::pair<It, It>>& chunks)
+  {
+    if (size == 0)
+    {
+      return;
+    }
+    size_t step = (size + parts - 1) / parts;
+    It next = std::next(first, step);
+    chunks.emplace_back(first, next);
+    splitRange(next, size - step, parts - 1, chunks);
+  }
+
+  struct ResultsMerger
+  {
+    SearchResults& merged;
+    size_t limit;
+
+    void operator()(std::future<SearchResults>& task) const
+    {
+      SearchResults part = task.get();
+      size_t take = std::min(part.size(), limit - std::min(limit, merged.size()));
+      std::move(part.begin(), part.begin() + take, std::back_inserter(merged));
+    }
+  };
+
+  SearchResults mergeResults(std::vector<std::future<SearchResults>>& tasks, size_t limit)
   {
-    std::vector<std::pair<std::string, std::pair<std::string, std::string>>>& results;
+    SearchResults merged;
+    std::for_each(tasks.begin(), tasks.end(), ResultsMerger{ merged, limit });
+    return merged;
+  }
+
+  struct EntryTaskLauncher
+  {
+    const std::string& dictId;
     const std::string& pattern;
+    size_t limit;
+    std::launch policy;
 
-    void operator()(const dictionaries::value_type& dictPair) const
+    std::future<SearchResults> operator()(const std::pair<dictionary::const_iterator, dictionary::const_iterator>& chunk) const
     {
-      const dictionary& dict = dictPair.second;
-      PatternMatcher matcher{ pattern };
+      return std::async(policy, searchEntries, std::cref(dictId), chunk.first, chunk.second, std::cref(pattern), limit);
+    }
+  };
 
-      dictionary::const_iterator it = dict.begin();
-      dictionary::const_iterator end = dict.end();
+  struct DictTaskLauncher
+  {
+    const std::string& pattern;
+    size_t limit;
+    std::launch policy;
+
+    std::future<SearchResults> operator()(const std::pair<dictionaries::const_iterator, dictionaries::const_iterator>& chunk) const
+    {
+      return std::async(policy, searchDicts, chunk.first, chunk.second, std::cref(pattern), limit);
+    }
+  };
 
-      if (it == end) return;
+  template< class It, class Launcher >
+  SearchResults runSearch(It first, size_t size, size_t parts, Launcher launcher, size_t limit)
+  {
+    std::vector<std::pair<It, It>> chunks;
+    splitRange(first, size, parts, chunks);
+    launcher.policy = chunks.size() > 1 ? std::launch::async : std::launch::deferred;
+    std::vector<std::future<SearchResults>> tasks;
+    std::transform(chunks.begin(), chunks.end(), std::back_inserter(tasks), launcher);
+    return mergeResults(tasks, limit);
+  }
 
-      if (matcher(*it))
-      {
-        results.emplace_back(dictPair.first, *it);
-      }
-      operator()(dictionaries::value_type(dictPair.first, dictionary(++it, end)));
+  bool readLimit(std::istream& in, size_t& limit)
+  {
+    std::string rest;
+    std::getline(in, rest);
+    std::istringstream args(rest);
+    limit = std::numeric_limits<size_t>::max();
+    long long value = 0;
+    if (!(args >> value))
+    {
+      return args.eof();
+    }
+    std::string extra;
+    if (value <= 0 || args >> extra)
+    {
+      return false;
+    }
+    limit = static_cast<size_t>(value);
+    return true;
+  }
+
+  struct SearchResultFormatter
+  {
+    std::string operator()(const SearchResult& item) const
+    {
+      return item.second.first + " - " + item.second.second;
     }
   };
 
   struct ResultFormatter
   {
-    std::string operator()(const std::pair<std::string, std::pair<std::string, std::string>>& item) const
+    std::string operator()(const SearchResult& item) const
     {
       return "[" + item.first + "] " + item.second.first + " - " + item.second.second;
     }
@@ -419,8 +549,9 @@ void kharlamov::doSearch(std::istream& in, std::ostream& out, const dictionaries
 {
   std::string dictId;
   std::string pattern;
+  size_t limit = 0;
 
-  if (!(in >> dictId >> pattern))
+  if (!(in >> dictId >> pattern) || !readLimit(in, limit))
   {
     out << "<INVALID COMMAND>\n";
     return;
@@ -434,11 +565,9 @@ void kharlamov::doSearch(std::istream& in, std::ostream& out, const dictionaries
   }
 
   const dictionary& dict = dictIt->second;
-  std::vector<std::pair<std::string, std::string>> matches;
-
-  PatternMatcher matcher;
-  matcher.pattern = pattern;
-  std::copy_if(dict.begin(), dict.end(), std::back_inserter(matches), matcher);
+  size_t parts = countTasks(dict.size(), minEntriesPerTask);
+  EntryTaskLauncher launcher{ dictIt->first, pattern, limit, std::launch::deferred };
+  SearchResults matches = runSearch(dict.begin(), dict.size(), parts, launcher, limit);
 
   if (matches.empty())
   {
@@ -446,10 +575,7 @@ void kharlamov::doSearch(std::istream& in, std::ostream& out, const dictionaries
     return;
   }
 
-  PairSorter sorter;
-  std::sort(matches.begin(), matches.end(), sorter);
-
-  EntryFormatter formatter;
+  SearchResultFormatter formatter;
   std::transform(matches.begin(), matches.end(), std::ostream_iterator<std::string>(out, "\n"), formatter);
 }
 
@@ -705,21 +831,18 @@ void kharlamov::doIntersect(std::istream& in, std::ostream& out, dictionaries& d
 void kharlamov::doGlobalsearch(std::istream& in, std::ostream& out, const dictionaries& dicts)
 {
   std::string pattern;
+  size_t limit = 0;
 
-  if (!(in >> pattern))
+  if (!(in >> pattern) || !readLimit(in, limit))
   {
     out << "<INVALID COMMAND>\n";
     return;
   }
 
-  std::vector<std::pair<std::string, std::pair<std::string, std::string>>> results;
-
-  if (!dicts.empty())
-  {
-    dictionaries::const_iterator it = dicts.begin();
-    ResultsCollector collector{ results, pattern };
-    collector(*it);
-  }
+  size_t total = std::accumulate(dicts.begin(), dicts.end(), size_t(0), TotalCounter());
+  size_t parts = std::min(countTasks(total, minEntriesPerTask), std::max(dicts.size(), size_t(1)));
+  DictTaskLauncher launcher{ pattern, limit, std::launch::deferred };
+  SearchResults results = runSearch(dicts.begin(), dicts.size(), parts, launcher, limit);
 
   if (results.empty())
   {
@@ -727,7 +850,6 @@ void kharlamov::doGlobalsearch(std::istream& in, std::ostream& out, const dictio
     return;
   }
 
-  std::sort(results.begin(), results.end());
   ResultFormatter formatter;
   std::transform(results.begin(), results.end(), std::ostream_iterator<std::string>(out, "\n"), formatter);
 }
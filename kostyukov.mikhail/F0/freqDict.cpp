@@ -35,6 +35,70 @@ namespace kostyukov
     return;
   }
 
+  void addCount(FrequencyDictionary& dict, const std::string& word, size_t count)
+  {
+    size_t& current = dict.counts[word];
+    if (current != 0)
+    {
+      auto bucket = dict.byCount.find(current);
+      bucket->second.erase(word);
+      if (bucket->second.empty())
+      {
+        dict.byCount.erase(bucket);
+      }
+    }
+    current += count;
+    dict.byCount[current].insert(word);
+    dict.totalWords += count;
+  }
+
+  void eraseWord(FrequencyDictionary& dict, const std::string& word)
+  {
+    auto wordIter = dict.counts.find(word);
+    if (wordIter == dict.counts.end())
+    {
+      return;
+    }
+    auto bucket = dict.byCount.find(wordIter->second);
+    bucket->second.erase(word);
+    if (bucket->second.empty())
+    {
+      dict.byCount.erase(bucket);
+    }
+    dict.totalWords -= wordIter->second;
+    dict.counts.erase(wordIter);
+  }
+
+  void clearDict(FrequencyDictionary& dict)
+  {
+    dict.counts.clear();
+    dict.byCount.clear();
+    dict.totalWords = 0;
+  }
+
+  void rebuildCountIndex(FrequencyDictionary& dict)
+  {
+    struct BucketInserter
+    {
+      CountIndex& byCount;
+      void operator()(const std::pair< const std::string, size_t >& pair) const
+      {
+        byCount[pair.second].insert(byCount[pair.second].end(), pair.first);
+      }
+    };
+    dict.byCount.clear();
+    std::for_each(dict.counts.begin(), dict.counts.end(), BucketInserter{ dict.byCount });
+  }
+
+  CountIndex::const_iterator findFreqBound(const FrequencyDictionary& dict, double freq, bool inclusive)
+  {
+    // clamp in double before the cast; std::max(0.0, x) also turns NaN into 0
+    double bound = std::max(0.0, freq * dict.totalWords / 100.0);
+    size_t estimate = static_cast< size_t >(std::min(bound, static_cast< double >(dict.totalWords)));
+    auto start = dict.byCount.lower_bound(estimate > 0 ? estimate - 1 : 0);
+    return std::find_if(start, dict.byCount.end(), FreqBoundPredicate(dict.totalWords, freq, inclusive));
+  }
+
   bool isValidName(const std::string& name)
   {
     if (name.empty() || !std::isalpha(name[0]))
@@ -89,11 +153,11 @@ namespace kostyukov
       return;
     }
     FrequencyDictionary& dict = dicts[dictName];
-    dict.counts.clear();
-    dict.totalWords = 0;
+    clearDict(dict);
     std::istream_iterator< std::string > start(file);
     std::istream_iterator< std::string > end;
     std::for_each(start, end, WordProcessor(dict));
+    rebuildCountIndex(dict);
     out << "successfully loaded " << dictName << '\n';
   }
 
@@ -159,14 +223,16 @@ namespace kostyukov
       out << "<EMPTY DICTIONARY>\n";
       return;
     }
-    std::vector< WordFreqPair > tempVec;
-    tempVec.reserve(dict.counts.size());
-    auto begin = dict.counts.begin();
-    auto end = dict.counts.end();
-    std::transform(begin, end, std::back_inserter(tempVec), MapToPairTransformer(dict.totalWords));
-    size_t limit = std::min(n, tempVec.size());
-    std::partial_sort(tempVec.begin(), tempVec.begin() + limit, tempVec.end(), FreqComparator(isBottom));
-    std::for_each(tempVec.begin(), tempVec.begin() + limit, PairPrinter(out));
+    size_t remaining = n;
+    BucketPrinter printer(out, dict.totalWords, remaining);
+    if (isBottom)
+    {
+      std::find_if(dict.byCount.begin(), dict.byCount.end(), printer);
+    }
+    else
+    {
+      std::find_if(dict.byCount.rbegin(), dict.byCount.rend(), printer);
+    }
   }
 
   void top(std::istream& in, std::ostream& out, const FreqDictManager& dicts)
@@ -317,8 +383,7 @@ namespace kostyukov
       out << "<DICTIONARY NOT FOUND>\n";
       return;
     }
-    dictIter->second.counts.clear();
-    dictIter->second.totalWords = 0;
+    clearDict(dictIter->second);
     out << "Dictionary " << dictName << " has been cleared\n";
   }
 
@@ -423,11 +488,26 @@ namespace kostyukov
       out << "<EMPTY DICTIONARY>\n";
       return;
     }
-    std::vector< std::pair< const std::string, size_t > > pairsToRemove;
-    auto begin = dict.counts.begin();
-    auto end = dict.counts.end();
-    auto pred = RemoveBatchPredicate(dict.totalWords, param == "freq_less", n);
-    std::copy_if(begin, end, std::back_inserter(pairsToRemove),pred);
+    auto first = dict.byCount.cbegin();
+    auto last = dict.byCount.cend();
+    if (param == "freq_less")
+    {
+      last = findFreqBound(dict, n, true);
+    }
+    else
+    {
+      first = findFreqBound(dict, n, false);
+    }
+    struct BucketCollector
+    {
+      std::vector< std::string >& words;
+      void operator()(const CountIndex::value_type& bucket) const
+      {
+        words.insert(words.end(), bucket.second.begin(), bucket.second.end());
+      }
+    };
+    std::vector< std::string > pairsToRemove;
+    std::for_each(first, last, BucketCollector{ pairsToRemove });
     if (pairsToRemove.empty())
     {
       out << "No words to remove\n";
@@ -475,29 +555,23 @@ namespace kostyukov
       out << "<EMPTY DICTIONARY>\n";
       return;
     }
-    std::vector< WordFreqPair > allPairs;
-    allPairs.reserve(dict.counts.size());
-    auto begin = dict.counts.begin();
-    auto end = dict.counts.end();
-    std::transform(begin, end, std::back_inserter(allPairs), MapToPairTransformer(dict.totalWords));
-    std::vector< WordFreqPair > filteredPairs;
-    filteredPairs.reserve(allPairs.size());
-    RangeFreqPredicate predicate(leftBorder, rightBorder);
-    if (inRange)
+    auto lower = findFreqBound(dict, leftBorder, true);
+    auto upper = findFreqBound(dict, rightBorder, false);
+    bool isEmpty = inRange ? (lower == upper) : (lower == dict.byCount.begin() && upper == dict.byCount.end());
+    if (isEmpty)
     {
-      std::copy_if(allPairs.begin(), allPairs.end(), std::back_inserter(filteredPairs), predicate);
-    }
-    else
-    {
-      std::copy_if(allPairs.begin(), allPairs.end(), std::back_inserter(filteredPairs), OutOfRangeFreqPredicate(leftBorder, rightBorder));
+      out << "No words found in this range\n";
+      return;
     }
-    if (filteredPairs.empty())
+    size_t remaining = dict.counts.size();
+    BucketPrinter printer(out, dict.totalWords, remaining);
+    if (inRange)
     {
-      out << "No words found in this range\n";
+      std::for_each(std::make_reverse_iterator(upper), std::make_reverse_iterator(lower), printer);
       return;
     }
-    std::sort(filteredPairs.begin(), filteredPairs.end(), FreqComparator(false));
-    std::for_each(filteredPairs.begin(), filteredPairs.end(), PairPrinter(out));
+    std::for_each(dict.byCount.rbegin(), std::make_reverse_iterator(upper), printer);
+    std::for_each(std::make_reverse_iterator(lower), dict.byCount.rend(), printer);
   }
 
   void rangeFreq(std::istream& in, std::ostream& out, const FreqDictManager& dicts)
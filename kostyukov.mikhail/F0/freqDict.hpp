@@ -3,16 +3,26 @@
 
 #include <iosfwd>
 #include <map>
+#include <set>
 #include <string>
 
 namespace kostyukov
 {
+  using CountIndex = std::map< size_t, std::set< std::string > >;
+
   struct FrequencyDictionary
   {
     std::map< std::string, size_t > counts;
+    CountIndex byCount;
     size_t totalWords = 0;
   };
 
+  void addCount(FrequencyDictionary& dict, const std::string& word, size_t count);
+  void eraseWord(FrequencyDictionary& dict, const std::string& word);
+  void clearDict(FrequencyDictionary& dict);
+  void rebuildCountIndex(FrequencyDictionary& dict);
+  CountIndex::const_iterator findFreqBound(const FrequencyDictionary& dict, double freq, bool inclusive);
+
   using FreqDictManager = std::map< std::string, FrequencyDictionary >;
 
   struct WordFreqPair
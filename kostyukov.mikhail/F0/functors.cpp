@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cctype>
 #include <iomanip>
+#include <iterator>
 
 #include "scopeGuard.hpp"
 
@@ -31,25 +32,6 @@ void kostyukov::WordProcessor::operator()(std::string word)
   }
 }
 
-kostyukov::MapToPairTransformer::MapToPairTransformer(size_t totalWords):
-  totalWords_(totalWords)
-{}
-
-kostyukov::WordFreqPair kostyukov::MapToPairTransformer::operator()(const std::pair< const std::string, size_t >& mapPair) const
-{
-  double freq = (totalWords_ == 0) ? 0.0 : (static_cast< double >(mapPair.second) / totalWords_) * 100.0;
-  return WordFreqPair{ mapPair.first, freq };
-}
-
-kostyukov::FreqComparator::FreqComparator(bool ascending):
-  ascending_(ascending)
-{}
-
-bool kostyukov::FreqComparator::operator()(const WordFreqPair& first, const WordFreqPair& second) const
-{
-  return (ascending_) ? first.freq < second.freq : first.freq > second.freq;
-}
-
 kostyukov::PairPrinter::PairPrinter(std::ostream& out):
   out_(out)
 {}
@@ -60,30 +42,13 @@ void kostyukov::PairPrinter::operator()(const WordFreqPair& pair) const
   out_ << pair.word << " - " << std::fixed << std::setprecision(1) << pair.freq << "%\n";
 }
 
-kostyukov::RemoveBatchPredicate::RemoveBatchPredicate(size_t total, bool less, double n):
-  totalWords_(total),
-  isLess_(less),
-  threshold_(n)
-{}
-
-bool kostyukov::RemoveBatchPredicate::operator()(const std::pair< const std::string, size_t >& pair) const
-{
-  if (totalWords_ == 0)
-  {
-    return false;
-  }
-  double freq = (static_cast< double >(pair.second) / totalWords_) * 100.0;
-  return isLess_ ? (freq < threshold_) : (freq > threshold_);
-}
-
 kostyukov::DictDeleter::DictDeleter(FrequencyDictionary& dict):
   dict_(dict)
 {}
 
-void kostyukov::DictDeleter::operator()(const std::pair< const std::string, size_t >& pairToRemove) const
+void kostyukov::DictDeleter::operator()(const std::string& word) const
 {
-  dict_.totalWords -= pairToRemove.second;
-  dict_.counts.erase(pairToRemove.first);
+  eraseWord(dict_, word);
 }
 
 std::string kostyukov::KeyExtractor::operator()(const std::pair< const std::string, size_t >& mapPair) const
@@ -97,24 +62,41 @@ void kostyukov::SameWordPrinter::operator()(const std::string& key) const
   out << key << " (in " << name1 << ": " << dict1.counts.at(key) << ", in " << name2 << ": " << dict2.counts.at(key) << ")\n";
 }
 
-kostyukov::RangeFreqPredicate::RangeFreqPredicate(double minVal, double maxVal):
-  minVal_(minVal),
-  maxVal_(maxVal)
+kostyukov::FreqBoundPredicate::FreqBoundPredicate(size_t totalWords, double bound, bool inclusive):
+  totalWords_(totalWords),
+  bound_(bound),
+  inclusive_(inclusive)
 {}
 
-bool kostyukov::RangeFreqPredicate::operator()(const WordFreqPair& pair) const
+bool kostyukov::FreqBoundPredicate::operator()(const CountIndex::value_type& bucket) const
 {
-  return pair.freq >= minVal_ && pair.freq <= maxVal_;
+  double freq = (static_cast< double >(bucket.first) / totalWords_) * 100.0;
+  return inclusive_ ? (freq >= bound_) : (freq > bound_);
 }
 
-kostyukov::OutOfRangeFreqPredicate::OutOfRangeFreqPredicate(double minVal, double maxVal):
-  minVal_(minVal),
-  maxVal_(maxVal)
+kostyukov::BucketPrinter::BucketPrinter(std::ostream& out, size_t totalWords, size_t& remaining):
+  out_(out),
+  totalWords_(totalWords),
+  remaining_(remaining)
 {}
 
-bool kostyukov::OutOfRangeFreqPredicate::operator()(const WordFreqPair& pair) const
+bool kostyukov::BucketPrinter::operator()(const CountIndex::value_type& bucket) const
 {
-  return pair.freq < minVal_ || pair.freq > maxVal_;
+  struct WordPrinter
+  {
+    PairPrinter printer;
+    double freq;
+    void operator()(const std::string& word) const
+    {
+      printer(WordFreqPair{ word, freq });
+    }
+  };
+  double freq = (totalWords_ == 0) ? 0.0 : (static_cast< double >(bucket.first) / totalWords_) * 100.0;
+  size_t taken = std::min(remaining_, bucket.second.size());
+  auto last = std::next(bucket.second.begin(), taken);
+  std::for_each(bucket.second.begin(), last, WordPrinter{ PairPrinter(out_), freq });
+  remaining_ -= taken;
+  return remaining_ == 0;
 }
 
 void kostyukov::DictNamePrinter::operator()(const std::pair< const std::string, FrequencyDictionary >& dictPair) const
@@ -128,8 +110,7 @@ kostyukov::MergeFunctor::MergeFunctor(FrequencyDictionary& targetDict):
 
 void kostyukov::MergeFunctor::operator()(const std::pair< const std::string, size_t >& pair)
 {
-  targetDict_.counts[pair.first] += pair.second;
-  targetDict_.totalWords += pair.second;
+  addCount(targetDict_, pair.first, pair.second);
 }
 
 kostyukov::IntersectFunctor::IntersectFunctor(FrequencyDictionary& targetDict, const FrequencyDictionary& otherDict, bool useMax):
@@ -146,7 +127,6 @@ void kostyukov::IntersectFunctor::operator()(const std::pair< const std::string,
     size_t freq1 = pair.second;
     size_t freq2 = otherIt->second;
     size_t newFreq = useMax_ ? std::max(freq1, freq2) : std::min(freq1, freq2);
-    targetDict_.counts[pair.first] = newFreq;
-    targetDict_.totalWords += newFreq;
+    addCount(targetDict_, pair.first, newFreq);
   }
 }
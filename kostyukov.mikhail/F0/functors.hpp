@@ -23,22 +23,6 @@ namespace kostyukov
       FrequencyDictionary& dict_;
   };
 
-  struct MapToPairTransformer
-  {
-    MapToPairTransformer(size_t totalWords);
-    WordFreqPair operator()(const std::pair< const std::string, size_t >& mapPair) const;
-    private:
-      size_t totalWords_;
-  };
-
-  struct FreqComparator
-  {
-    explicit FreqComparator(bool ascending = false);
-    bool operator()(const WordFreqPair& first, const WordFreqPair& second) const;
-    private:
-      bool ascending_;
-  };
-
   struct PairPrinter
   {
     explicit PairPrinter(std::ostream& out);
@@ -52,20 +36,10 @@ namespace kostyukov
     std::string operator()(const std::pair< const std::string, size_t >& mapPair) const;
   };
 
-  struct RemoveBatchPredicate
-  {
-    RemoveBatchPredicate(size_t total, bool less, double n);
-    bool operator()(const std::pair< const std::string, size_t >& pair) const;
-    private:
-      size_t totalWords_;
-      bool isLess_;
-      double threshold_;
-  };
-
   struct DictDeleter
   {
     explicit DictDeleter(FrequencyDictionary& dict);
-    void operator()(const std::pair< const std::string, size_t >& pairToRemove) const;
+    void operator()(const std::string& word) const;
     private:
       FrequencyDictionary& dict_;
   };
@@ -80,22 +54,24 @@ namespace kostyukov
     void operator()(const std::string& key) const;
   };
 
-  struct RangeFreqPredicate
+  struct FreqBoundPredicate
   {
-    RangeFreqPredicate(double minVal, double maxVal);
-    bool operator()(const WordFreqPair& pair) const;
+    FreqBoundPredicate(size_t totalWords, double bound, bool inclusive);
+    bool operator()(const CountIndex::value_type& bucket) const;
     private:
-      double minVal_;
-      double maxVal_;
+      size_t totalWords_;
+      double bound_;
+      bool inclusive_;
   };
 
-  struct OutOfRangeFreqPredicate
+  struct BucketPrinter
   {
-    OutOfRangeFreqPredicate(double minVal, double maxVal);
-    bool operator()(const WordFreqPair& pair) const;
+    BucketPrinter(std::ostream& out, size_t totalWords, size_t& remaining);
+    bool operator()(const CountIndex::value_type& bucket) const;
     private:
-      double minVal_;
-      double maxVal_;
+      std::ostream& out_;
+      size_t totalWords_;
+      size_t& remaining_;
   };
 
   struct DictNamePrinter
@@ -2,6 +2,7 @@
 #include "wordFunctors.hpp"
 #include "outputFunctors.hpp"
 #include "splitFunctors.hpp"
+#include "postings.hpp"
 #include "index.hpp"
 #include <fstream>
 #include <iostream>
@@ -27,9 +28,10 @@ void krylov::CommandProcessor::initializeCommands()
   commands["zip"] = std::bind(&CommandProcessor::zipTextsCmd, this, _1);
   commands["list"] = std::bind(&CommandProcessor::listIndexesCmd, this, _1);
   commands["deleteindex"] = std::bind(&CommandProcessor::deleteIndexCmd, this, _1);
-  commands["weave"] = std::bind(&CommandProcessor::deleteIndexCmd, this, _1);
-  commands["intersect"] = std::bind(&CommandProcessor::deleteIndexCmd, this, _1);
-  commands["diff"] = std::bind(&CommandProcessor::deleteIndexCmd, this, _1);
+  commands["weave"] = std::bind(&CommandProcessor::weaveTextsCmd, this, _1);
+  commands["intersect"] = std::bind(&CommandProcessor::intersectIndexesCmd, this, _1);
+  commands["diff"] = std::bind(&CommandProcessor::diffIndexesCmd, this, _1);
+  commands["query"] = std::bind(&CommandProcessor::queryIndexCmd, this, _1);
 }
 
 void krylov::CommandProcessor::execute(const std::string& line)
@@ -85,8 +87,10 @@ void krylov::CommandProcessor::createIndex(const std::string& indexName, const s
   std::vector< size_t > lineNumbers(newIndex.lines.size());
   std::iota(lineNumbers.begin(), lineNumbers.end(), 0);
 
-  SplitWords processor{ newIndex.lines, newIndex.index };
+  std::vector< WordOccurrence > occurrences;
+  SplitWords processor{ newIndex.lines, occurrences };
   std::transform(lineNumbers.begin(), lineNumbers.end(), lineNumbers.begin(), processor);
+  newIndex.index = buildDictionary(occurrences);
 
   indexes_[indexName] = std::move(newIndex);
   out_ << "Index " << indexName << " created successfully" << '\n';
@@ -151,10 +155,11 @@ void krylov::CommandProcessor::mergeIndexes(const std::string& index1, const std
 
   IndexDocument result;
 
-  std::copy(it1->second.index.begin(), it1->second.index.end(), std::inserter(result.index, result.index.end()));
-
   size_t offset = it1->second.lines.size();
-  std::for_each(it2->second.index.begin(), it2->second.index.end(), MergeWithOffset{ result, offset });
+  IndexDictionary shifted;
+  shifted.reserve(it2->second.index.size());
+  std::transform(it2->second.index.begin(), it2->second.index.end(), std::back_inserter(shifted), ShiftEntry{ offset });
+  result.index = mergeDictionaries(it1->second.index, shifted);
 
   std::vector< std::string >& lines1 = it1->second.lines;
   std::vector< std::string >& lines2 = it2->second.lines;
@@ -187,7 +192,9 @@ void krylov::CommandProcessor::zipTexts(const std::string& index1, const std::st
   std::vector< size_t > lineNumbers(maxSize);
   std::iota(lineNumbers.begin(), lineNumbers.end(), 1);
 
-  std::transform(lineNumbers.begin(), lineNumbers.end(), lineNumbers.begin(), SplitAndAdd{ resultIndex, resultIndex.lines });
+  std::vector< WordOccurrence > occurrences;
+  std::transform(lineNumbers.begin(), lineNumbers.end(), lineNumbers.begin(), SplitAndAdd{ occurrences, resultIndex.lines });
+  resultIndex.index = buildDictionary(occurrences);
 
   indexes_[newIndex] = std::move(resultIndex);
   out_ << "Index " << newIndex << " created by merging lines" << '\n';
@@ -202,11 +209,7 @@ void krylov::CommandProcessor::intersectIndexes(const std::string& index1, const
     throw std::invalid_argument("Invalid command");
   }
   IndexDocument result;
-  const auto& idx1 = it1->second.index;
-  const auto& idx2 = it2->second.index;
-  std::vector<IndexDictionary::value_type> tempResult;
-  std::copy_if(idx1.begin(), idx1.end(), std::back_inserter(tempResult), IsInSecondIndex{ idx2 });
-  std::transform(tempResult.begin(), tempResult.end(), std::inserter(result.index, result.index.begin()), MergeEntries{idx2});
+  result.index = intersectDictionaries(it1->second.index, it2->second.index);
   indexes_[newIndex] = std::move(result);
   out_ << "Index " << newIndex << " created by intersection" << '\n';
 }
@@ -228,7 +231,9 @@ void krylov::CommandProcessor::weaveTexts(const std::string& index1, const std::
   resultIndex.lines = newText;
   std::vector< size_t > lineNumbers(newText.size());
   std::iota(lineNumbers.begin(), lineNumbers.end(), 1);
-  std::transform(lineNumbers.begin(), lineNumbers.end(), lineNumbers.begin(), SplitAndAdd{ resultIndex, resultIndex.lines });
+  std::vector< WordOccurrence > occurrences;
+  std::transform(lineNumbers.begin(), lineNumbers.end(), lineNumbers.begin(), SplitAndAdd{ occurrences, resultIndex.lines });
+  resultIndex.index = buildDictionary(occurrences);
   indexes_[newIndex] = std::move(resultIndex);
   out_ << "Index " << newIndex << " created by weaving" << '\n';
 }
@@ -242,13 +247,28 @@ void krylov::CommandProcessor::diffIndexes(const std::string& index1, const std:
     throw std::invalid_argument("Invalid command");
   }
   IndexDocument result;
-  const auto& idx1 = it1->second.index;
-  const auto& idx2 = it2->second.index;
-  std::copy_if(idx1.begin(), idx1.end(), std::inserter(result.index, result.index.begin()), IsNotInSecondIndex{ idx2 });
+  result.index = subtractDictionaries(it1->second.index, it2->second.index);
   indexes_[newIndex] = std::move(result);
   out_ << "Index " << newIndex << " created by difference" << '\n';
 }
 
+void krylov::CommandProcessor::queryIndex(const std::string& indexName, const std::vector< std::string >& expression)
+{
+  auto it = indexes_.find(indexName);
+  if (it == indexes_.end())
+  {
+    throw std::invalid_argument("Invalid command");
+  }
+
+  Postings lines = QueryEvaluator(it->second, expression)();
+  if (lines.empty())
+  {
+    out_ << "<NOT FOUND>\n";
+    return;
+  }
+  out_ << lines << '\n';
+}
+
 void krylov::CommandProcessor::intersectIndexesCmd(const std::vector< std::string >& args)
 {
   if (args.size() != 3)
@@ -276,6 +296,16 @@ void krylov::CommandProcessor::diffIndexesCmd(const std::vector< std::string >&
   diffIndexes(args[0], args[1], args[2]);
 }
 
+void krylov::CommandProcessor::queryIndexCmd(const std::vector< std::string >& args)
+{
+  if (args.size() < 2)
+  {
+    throw std::invalid_argument("Invalid command");
+  }
+  std::vector< std::string > expression(args.begin() + 1, args.end());
+  queryIndex(args[0], expression);
+}
+
 void krylov::CommandProcessor::createIndexCmd(const std::vector< std::string >& args)
 {
   if (args.size() != 2)
@@ -30,10 +30,12 @@ namespace krylov
     void intersectIndexes(const std::string& index1, const std::string& index2, const std::string& newIndex);
     void weaveTexts(const std::string& index1, const std::string& index2, const std::string& newIndex);
     void diffIndexes(const std::string& index1, const std::string& index2, const std::string& newIndex);
+    void queryIndex(const std::string& indexName, const std::vector< std::string >& expression);
 
     void intersectIndexesCmd(const std::vector< std::string >& args);
     void weaveTextsCmd(const std::vector< std::string >& args);
     void diffIndexesCmd(const std::vector< std::string >& args);
+    void queryIndexCmd(const std::vector< std::string >& args);
     void createIndexCmd(const std::vector< std::string >& args);
     void printIndexCmd(const std::vector< std::string >& args);
     void findWordCmd(const std::vector< std::string >& args);
@@ -43,36 +45,6 @@ namespace krylov
     void deleteIndexCmd(const std::vector< std::string >& args);
   };
 
-  struct IsInSecondIndex
-  {
-    const krylov::IndexDictionary& idx2;
-    bool operator()(const krylov::IndexDictionary::value_type& entry) const
-    {
-      return idx2.find(entry.first) != idx2.end();
-    }
-  };
-
-  struct MergeEntries
-  {
-    const krylov::IndexDictionary& idx2;
-    krylov::IndexDictionary::value_type operator()(const krylov::IndexDictionary::value_type& entry) const
-    {
-      std::set< size_t > merged;
-      std::set_union(entry.second.begin(), entry.second.end(), idx2.at(entry.first).begin(),
-        idx2.at(entry.first).end(), std::inserter(merged, merged.begin()));
-      return std::make_pair(entry.first, merged);
-    }
-  };
-
-  struct IsNotInSecondIndex
-  {
-    const krylov::IndexDictionary& idx2;
-    bool operator()(const krylov::IndexDictionary::value_type& entry) const
-    {
-      return idx2.find(entry.first) == idx2.end();
-    }
-  };
-
   struct WeaveLinesGenerator
   {
     const std::vector< std::string >& lines1;
@@ -1,15 +1,14 @@
 #include "index.hpp"
 #include "splitFunctors.hpp"
 #include <iostream>
-#include <set>
 #include <iterator>
 #include <algorithm>
 
-krylov::WordEntry::WordEntry(const std::pair< const std::string, std::set< size_t > >& p):
+krylov::WordEntry::WordEntry(const IndexEntry& p):
   word(p.first), lines(p.second)
 {}
 
-std::ostream& krylov::operator<<(std::ostream& out, const std::set< size_t >& s)
+std::ostream& krylov::operator<<(std::ostream& out, const Postings& s)
 {
   if (s.empty())
   {
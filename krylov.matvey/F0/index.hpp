@@ -2,21 +2,23 @@
 #define INDEX_HPP
 
 #include <map>
-#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace krylov
 {
-  using IndexDictionary = std::map< std::string, std::set< std::size_t > >;
+  using Postings = std::vector< std::size_t >;
+  using IndexEntry = std::pair< std::string, Postings >;
+  using IndexDictionary = std::vector< IndexEntry >;
 
   struct WordEntry
   {
     const std::string& word;
-    const std::set< size_t >& lines;
-    WordEntry(const std::pair< const std::string, std::set< size_t > >& p);
+    const Postings& lines;
+    WordEntry(const IndexEntry& p);
   };
-  std::ostream& operator<<(std::ostream& out, const std::set< size_t >& s);
+  std::ostream& operator<<(std::ostream& out, const Postings& s);
   std::ostream& operator<<(std::ostream& out, const WordEntry& entry);
 
   struct IndexDocument
@@ -1,9 +1,8 @@
 #include <iostream>
 #include <fstream>
-#include <map>
-#include <functional>
-#include <limits>
+#include <string>
 #include "commands.hpp"
+#include "splitFunctors.hpp"
 
 int main(int argc, char** argv)
 {
@@ -26,19 +25,20 @@ int main(int argc, char** argv)
     }
   }
 
-  std::map< std::string, std::function< void() > > commands;
-  std::string command;
-  while (!(std::cin >> command).eof())
+  std::string line;
+  while (std::getline(std::cin, line))
   {
+    if (krylov::countWords(line) == 0)
+    {
+      continue;
+    }
     try
     {
-      commands.at(command)();
+      processor.execute(line);
     }
     catch (const std::exception& e)
     {
       std::cout << "<INVALID COMMAND>" << "\n";
-      std::cin.clear();
-      std::cin.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
     }
   }
 }
@@ -49,16 +49,15 @@ std::size_t krylov::AddOffset::operator()(std::size_t val) const
   return val + offset;
 }
 
-void krylov::MergeWithOffset::operator()(const std::pair< const std::string, std::set< std::size_t > >& pair) const
+krylov::IndexEntry krylov::ShiftEntry::operator()(const IndexEntry& entry) const
 {
-  std::set< std::size_t > adjusted;
-  std::transform(pair.second.begin(), pair.second.end(), std::inserter(adjusted, adjusted.end()), AddOffset{ offset });
-
-  auto& target = dest.index[pair.first];
-  target.insert(adjusted.begin(), adjusted.end());
+  Postings adjusted;
+  adjusted.reserve(entry.second.size());
+  std::transform(entry.second.begin(), entry.second.end(), std::back_inserter(adjusted), AddOffset{ offset });
+  return IndexEntry{ entry.first, std::move(adjusted) };
 }
 
-krylov::WordEntry krylov::pairToWordEntry(const IndexDictionary::value_type& p)
+krylov::WordEntry krylov::pairToWordEntry(const IndexEntry& p)
 {
   return WordEntry(p);
 }
@@ -4,7 +4,6 @@
 #include <string>
 #include <iosfwd>
 #include <map>
-#include <set>
 #include <vector>
 #include "index.hpp"
 
@@ -26,14 +25,13 @@ namespace krylov
     std::size_t operator()(std::size_t val) const;
   };
 
-  struct MergeWithOffset
+  struct ShiftEntry
   {
-    IndexDocument& dest;
     std::size_t offset;
-    void operator()(const std::pair<const std::string, std::set< std::size_t > >& pair) const;
+    IndexEntry operator()(const IndexEntry& entry) const;
   };
 
-  WordEntry pairToWordEntry(const IndexDictionary::value_type& p);
+  WordEntry pairToWordEntry(const IndexEntry& p);
 
   std::string showEntryToString(const std::pair< std::string, std::size_t >& p);
 }
@@ -0,0 +1,278 @@
+#include "postings.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+
+namespace
+{
+  const std::size_t gallopRatio = 8;
+
+  template< class It, class T, class Compare >
+  It gallop(It first, It last, const T& value, Compare less, typename std::iterator_traits< It >::difference_type step)
+  {
+    if (last - first <= step)
+    {
+      return std::lower_bound(first, last, value, less);
+    }
+    It bound = first + step;
+    if (!less(*bound, value))
+    {
+      return std::lower_bound(first, bound, value, less);
+    }
+    return gallop(bound + 1, last, value, less, step * 2);
+  }
+
+  struct EntryLess
+  {
+    bool operator()(const krylov::IndexEntry& lhs, const krylov::IndexEntry& rhs) const
+    {
+      return lhs.first < rhs.first;
+    }
+    bool operator()(const krylov::IndexEntry& lhs, const std::string& rhs) const
+    {
+      return lhs.first < rhs;
+    }
+  };
+
+  struct GroupOccurrence
+  {
+    krylov::IndexDictionary& dict;
+    void operator()(krylov::WordOccurrence& occurrence) const
+    {
+      if (dict.empty() || dict.back().first != occurrence.first)
+      {
+        dict.emplace_back(std::move(occurrence.first), krylov::Postings{ occurrence.second });
+        return;
+      }
+      krylov::Postings& lines = dict.back().second;
+      if (lines.back() != occurrence.second)
+      {
+        lines.push_back(occurrence.second);
+      }
+    }
+  };
+
+  struct GallopingFilter
+  {
+    krylov::Postings::const_iterator cur;
+    krylov::Postings::const_iterator last;
+    krylov::Postings& out;
+    bool keepFound;
+    void operator()(std::size_t line)
+    {
+      cur = gallop(cur, last, line, std::less< std::size_t >(), 1);
+      bool found = cur != last && *cur == line;
+      if (found == keepFound)
+      {
+        out.push_back(line);
+      }
+    }
+  };
+
+  struct EntryIntersector
+  {
+    krylov::IndexDictionary::const_iterator cur;
+    krylov::IndexDictionary::const_iterator last;
+    krylov::IndexDictionary& out;
+    void operator()(const krylov::IndexEntry& entry)
+    {
+      cur = gallop(cur, last, entry.first, EntryLess(), 1);
+      if (cur != last && cur->first == entry.first)
+      {
+        out.emplace_back(entry.first, krylov::unitePostings(entry.second, cur->second));
+      }
+    }
+  };
+
+  struct EntrySubtractor
+  {
+    krylov::IndexDictionary::const_iterator cur;
+    krylov::IndexDictionary::const_iterator last;
+    krylov::IndexDictionary& out;
+    void operator()(const krylov::IndexEntry& entry)
+    {
+      cur = gallop(cur, last, entry.first, EntryLess(), 1);
+      if (cur == last || cur->first != entry.first)
+      {
+        out.push_back(entry);
+      }
+    }
+  };
+
+  struct EntryFolder
+  {
+    krylov::IndexDictionary& out;
+    void operator()(krylov::IndexEntry& entry) const
+    {
+      if (!out.empty() && out.back().first == entry.first)
+      {
+        out.back().second = krylov::unitePostings(out.back().second, entry.second);
+        return;
+      }
+      out.push_back(std::move(entry));
+    }
+  };
+}
+
+krylov::IndexDictionary krylov::buildDictionary(std::vector< WordOccurrence >& occurrences)
+{
+  std::sort(occurrences.begin(), occurrences.end());
+  IndexDictionary dict;
+  std::for_each(occurrences.begin(), occurrences.end(), GroupOccurrence{ dict });
+  dict.shrink_to_fit();
+  return dict;
+}
+
+krylov::IndexDictionary::const_iterator krylov::findEntry(const IndexDictionary& dict, const std::string& word)
+{
+  auto it = std::lower_bound(dict.begin(), dict.end(), word, EntryLess());
+  if (it != dict.end() && it->first == word)
+  {
+    return it;
+  }
+  return dict.end();
+}
+
+krylov::Postings krylov::intersectPostings(const Postings& lhs, const Postings& rhs)
+{
+  const Postings& small = lhs.size() < rhs.size() ? lhs : rhs;
+  const Postings& large = lhs.size() < rhs.size() ? rhs : lhs;
+  Postings result;
+  result.reserve(small.size());
+  if (large.size() < small.size() * gallopRatio)
+  {
+    std::set_intersection(small.begin(), small.end(), large.begin(), large.end(), std::back_inserter(result));
+    return result;
+  }
+  std::for_each(small.begin(), small.end(), GallopingFilter{ large.begin(), large.end(), result, true });
+  return result;
+}
+
+krylov::Postings krylov::unitePostings(const Postings& lhs, const Postings& rhs)
+{
+  Postings result;
+  result.reserve(lhs.size() + rhs.size());
+  std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+  return result;
+}
+
+krylov::Postings krylov::subtractPostings(const Postings& lhs, const Postings& rhs)
+{
+  Postings result;
+  result.reserve(lhs.size());
+  if (rhs.size() < lhs.size() * gallopRatio)
+  {
+    std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+    return result;
+  }
+  std::for_each(lhs.begin(), lhs.end(), GallopingFilter{ rhs.begin(), rhs.end(), result, false });
+  return result;
+}
+
+krylov::IndexDictionary krylov::intersectDictionaries(const IndexDictionary& lhs, const IndexDictionary& rhs)
+{
+  const IndexDictionary& small = lhs.size() < rhs.size() ? lhs : rhs;
+  const IndexDictionary& large = lhs.size() < rhs.size() ? rhs : lhs;
+  IndexDictionary result;
+  std::for_each(small.begin(), small.end(), EntryIntersector{ large.begin(), large.end(), result });
+  return result;
+}
+
+krylov::IndexDictionary krylov::subtractDictionaries(const IndexDictionary& lhs, const IndexDictionary& rhs)
+{
+  IndexDictionary result;
+  std::for_each(lhs.begin(), lhs.end(), EntrySubtractor{ rhs.begin(), rhs.end(), result });
+  return result;
+}
+
+krylov::IndexDictionary krylov::mergeDictionaries(const IndexDictionary& lhs, const IndexDictionary& rhs)
+{
+  IndexDictionary merged;
+  merged.reserve(lhs.size() + rhs.size());
+  std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(merged), EntryLess());
+  IndexDictionary result;
+  result.reserve(merged.size());
+  std::for_each(merged.begin(), merged.end(), EntryFolder{ result });
+  return result;
+}
+
+krylov::QueryEvaluator::QueryEvaluator(const IndexDocument& doc_, const std::vector< std::string >& tokens_):
+  doc(doc_), tokens(tokens_), pos(0)
+{}
+
+krylov::Postings krylov::QueryEvaluator::operator()()
+{
+  Postings result = parseOr();
+  if (pos != tokens.size())
+  {
+    throw std::invalid_argument("Invalid command");
+  }
+  return result;
+}
+
+krylov::Postings krylov::QueryEvaluator::parseOr()
+{
+  return parseOrTail(parseAnd());
+}
+
+krylov::Postings krylov::QueryEvaluator::parseOrTail(Postings left)
+{
+  if (!nextIs("OR"))
+  {
+    return left;
+  }
+  ++pos;
+  Postings right = parseAnd();
+  return parseOrTail(unitePostings(left, right));
+}
+
+krylov::Postings krylov::QueryEvaluator::parseAnd()
+{
+  return parseAndTail(parseUnary());
+}
+
+krylov::Postings krylov::QueryEvaluator::parseAndTail(Postings left)
+{
+  if (!nextIs("AND"))
+  {
+    return left;
+  }
+  ++pos;
+  if (nextIs("NOT"))
+  {
+    ++pos;
+    Postings right = parseUnary();
+    return parseAndTail(subtractPostings(left, right));
+  }
+  Postings right = parseUnary();
+  return parseAndTail(intersectPostings(left, right));
+}
+
+krylov::Postings krylov::QueryEvaluator::parseUnary()
+{
+  if (pos == tokens.size() || nextIs("AND") || nextIs("OR"))
+  {
+    throw std::invalid_argument("Invalid command");
+  }
+  if (nextIs("NOT"))
+  {
+    ++pos;
+    Postings all(doc.lines.size());
+    std::iota(all.begin(), all.end(), 1);
+    Postings excluded = parseUnary();
+    return subtractPostings(all, excluded);
+  }
+  auto it = findEntry(doc.index, tokens[pos++]);
+  if (it == doc.index.end())
+  {
+    return {};
+  }
+  return it->second;
+}
+
+bool krylov::QueryEvaluator::nextIs(const char* op) const
+{
+  return pos < tokens.size() && tokens[pos] == op;
+}
@@ -0,0 +1,41 @@
+#ifndef POSTINGS_HPP
+#define POSTINGS_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "index.hpp"
+
+namespace krylov
+{
+  using WordOccurrence = std::pair< std::string, std::size_t >;
+
+  IndexDictionary buildDictionary(std::vector< WordOccurrence >& occurrences);
+  IndexDictionary::const_iterator findEntry(const IndexDictionary& dict, const std::string& word);
+
+  Postings intersectPostings(const Postings& lhs, const Postings& rhs);
+  Postings unitePostings(const Postings& lhs, const Postings& rhs);
+  Postings subtractPostings(const Postings& lhs, const Postings& rhs);
+
+  IndexDictionary intersectDictionaries(const IndexDictionary& lhs, const IndexDictionary& rhs);
+  IndexDictionary subtractDictionaries(const IndexDictionary& lhs, const IndexDictionary& rhs);
+  IndexDictionary mergeDictionaries(const IndexDictionary& lhs, const IndexDictionary& rhs);
+
+  struct QueryEvaluator
+  {
+    const IndexDocument& doc;
+    const std::vector< std::string >& tokens;
+    std::size_t pos;
+    QueryEvaluator(const IndexDocument& doc_, const std::vector< std::string >& tokens_);
+    Postings operator()();
+  private:
+    Postings parseOr();
+    Postings parseOrTail(Postings left);
+    Postings parseAnd();
+    Postings parseAndTail(Postings left);
+    Postings parseUnary();
+    bool nextIs(const char* op) const;
+  };
+}
+
+#endif
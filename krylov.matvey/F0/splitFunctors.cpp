@@ -4,7 +4,7 @@
 
 std::string krylov::LineSplitter::operator()(const std::string& word) const
 {
-  wordMap[word].insert(lineNumber);
+  occurrences.emplace_back(word, lineNumber);
   return word;
 }
 
@@ -22,7 +22,7 @@ std::size_t krylov::SplitWords::operator()(std::size_t lineNumber) const
   WordGenerator gen{ line.begin(), line.end() };
   std::generate_n(std::back_inserter(words),wordCount, gen);
 
-  std::transform(words.begin(), words.end(), words.begin(), LineSplitter{ wordMap, lineNumber + 1 });
+  std::transform(words.begin(), words.end(), words.begin(), LineSplitter{ occurrences, lineNumber + 1 });
 
   return lineNumber;
 }
@@ -71,6 +71,6 @@ std::size_t krylov::SplitAndAdd::operator()(std::size_t lineNum) const
   WordGenerator gen{ line.begin(), line.end() };
   std::generate_n(std::back_inserter(words), wordCount, gen);
 
-  std::transform(words.begin(), words.end(), words.begin(), LineSplitter{ idx.index, lineNum });
+  std::transform(words.begin(), words.end(), words.begin(), LineSplitter{ occurrences, lineNum });
   return lineNum;
 }
@@ -2,15 +2,15 @@
 #define SPLIT_FUNCTORS_HPP
 
 #include <string>
-#include <map>
-#include <set>
+#include <vector>
 #include "index.hpp"
+#include "postings.hpp"
 
 namespace krylov
 {
   struct LineSplitter
   {
-    IndexDictionary& wordMap;
+    std::vector< WordOccurrence >& occurrences;
     std::size_t lineNumber;
     std::string operator()(const std::string& word) const;
   };
@@ -18,7 +18,7 @@ namespace krylov
   struct SplitWords
   {
     std::vector< std::string >& lines;
-    IndexDictionary& wordMap;
+    std::vector< WordOccurrence >& occurrences;
     std::size_t operator()(std::size_t lineNumber) const;
   };
 
@@ -44,7 +44,7 @@ namespace krylov
 
   struct SplitAndAdd
   {
-    IndexDocument& idx;
+    std::vector< WordOccurrence >& occurrences;
     std::vector< std::string >& lines;
     std::size_t operator()(std::size_t lineNum) const;
   };
@@ -1,5 +1,6 @@
 #include "wordFunctors.hpp"
 #include "index.hpp"
+#include "postings.hpp"
 #include <iostream>
 #include <algorithm>
 #include <iterator>
@@ -14,7 +15,7 @@ krylov::FindWord::FindWord(
 
 void krylov::FindWord::operator()() const
 {
-  auto it = index.index.find(word);
+  auto it = findEntry(index.index, word);
 
   if (it == index.index.end())
   {
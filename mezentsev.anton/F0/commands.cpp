@@ -101,6 +101,183 @@ namespace
     collectSuggestions(dict, std::next(it), prefix, n - 1, result);
   }
 
+  struct Suggestion
+  {
+    size_t distance;
+    size_t weight;
+    std::string word;
+  };
+
+  struct SuggestionOrder
+  {
+    bool operator()(const Suggestion& lhs, const Suggestion& rhs) const
+    {
+      if (lhs.distance != rhs.distance)
+      {
+        return lhs.distance < rhs.distance;
+      }
+      if (lhs.weight != rhs.weight)
+      {
+        return lhs.weight > rhs.weight;
+      }
+      return lhs.word < rhs.word;
+    }
+  };
+
+  struct TopSuggestions
+  {
+    size_t limit;
+    std::set< Suggestion, SuggestionOrder > best;
+
+    bool full() const
+    {
+      return best.size() >= limit;
+    }
+
+    size_t worstDistance() const
+    {
+      return std::prev(best.end())->distance;
+    }
+
+    void offer(const std::pair< const std::string, mezentsev::Translations >& entry, size_t distance)
+    {
+      if (limit == 0)
+      {
+        return;
+      }
+      if (full())
+      {
+        const Suggestion& worst = *std::prev(best.end());
+        bool worse = distance > worst.distance || (distance == worst.distance && entry.second.size() < worst.weight);
+        if (worse || !SuggestionOrder()(Suggestion{ distance, entry.second.size(), entry.first }, worst))
+        {
+          return;
+        }
+      }
+      best.insert(Suggestion{ distance, entry.second.size(), entry.first });
+      if (best.size() > limit)
+      {
+        best.erase(std::prev(best.end()));
+      }
+    }
+  };
+
+  struct SuggestionOffer
+  {
+    TopSuggestions& top;
+    size_t distance;
+    void operator()(const std::pair< const std::string, mezentsev::Translations >& entry) const
+    {
+      top.offer(entry, distance);
+    }
+  };
+
+  struct SuggestionWord
+  {
+    const std::string& operator()(const Suggestion& suggestion) const
+    {
+      return suggestion.word;
+    }
+  };
+
+  struct IsNotMaxChar
+  {
+    bool operator()(char c) const
+    {
+      return static_cast< unsigned char >(c) != 0xFF;
+    }
+  };
+
+  mezentsev::Dictionary::const_iterator prefixEnd(const mezentsev::Dictionary& dict, std::string prefix)
+  {
+    prefix.erase(std::find_if(prefix.rbegin(), prefix.rend(), IsNotMaxChar()).base(), prefix.end());
+    if (prefix.empty())
+    {
+      return dict.end();
+    }
+    prefix.back() = static_cast< char >(static_cast< unsigned char >(prefix.back()) + 1);
+    return dict.lower_bound(prefix);
+  }
+
+  void fillDistanceRow(const std::vector< size_t >& prev, std::vector< size_t >& next,
+      const std::string& pattern, char c, size_t j)
+  {
+    if (j > pattern.size())
+    {
+      return;
+    }
+    size_t substitution = prev[j - 1] + (pattern[j - 1] == c ? 0 : 1);
+    next[j] = std::min(std::min(prev[j], next[j - 1]) + 1, substitution);
+    fillDistanceRow(prev, next, pattern, c, j + 1);
+  }
+
+  struct FuzzySearch
+  {
+    const mezentsev::Dictionary& dict;
+    const std::string& pattern;
+    size_t maxTypos;
+    TopSuggestions& top;
+
+    void visitNode(const std::string& node, mezentsev::Dictionary::const_iterator first,
+        mezentsev::Dictionary::const_iterator last, const std::vector< size_t >& row, size_t best) const
+    {
+      best = std::min(best, row.back());
+      if (*std::min_element(row.begin(), row.end()) > maxTypos)
+      {
+        if (best <= maxTypos && !(top.full() && top.worstDistance() < best))
+        {
+          std::for_each(first, last, SuggestionOffer{ top, best });
+        }
+        return;
+      }
+      if (first != last && first->first.size() == node.size())
+      {
+        if (best <= maxTypos)
+        {
+          top.offer(*first, best);
+        }
+        ++first;
+      }
+      visitChildren(node, first, last, row, best);
+    }
+
+    void visitChildren(const std::string& node, mezentsev::Dictionary::const_iterator first,
+        mezentsev::Dictionary::const_iterator last, const std::vector< size_t >& row, size_t best) const
+    {
+      if (first == last)
+      {
+        return;
+      }
+      std::string child = node + first->first[node.size()];
+      auto childLast = prefixEnd(dict, child);
+      std::vector< size_t > childRow(row.size());
+      childRow[0] = row[0] + 1;
+      fillDistanceRow(row, childRow, pattern, child.back(), 1);
+      visitNode(child, first, childLast, childRow, best);
+      visitChildren(node, childLast, last, row, best);
+    }
+  };
+
+  void collectFuzzySuggestions(const mezentsev::Dictionary& dict, const std::string& prefix,
+      size_t typos, size_t maxTypos, TopSuggestions& top)
+  {
+    if (typos > maxTypos || top.full())
+    {
+      return;
+    }
+    std::vector< size_t > row(prefix.size() + 1);
+    std::iota(row.begin(), row.end(), 0);
+    FuzzySearch search{ dict, prefix, typos, top };
+    search.visitNode(std::string(), dict.begin(), dict.end(), row, row.back());
+    collectFuzzySuggestions(dict, prefix, typos + 1, maxTypos, top);
+  }
+
+  void collectRankedSuggestions(mezentsev::Dictionary::const_iterator it,
+      mezentsev::Dictionary::const_iterator end, TopSuggestions& top)
+  {
+    std::for_each(it, end, SuggestionOffer{ top, 0 });
+  }
+
   void collectWordsByPrefix(mezentsev::Dictionary::const_iterator it,
       mezentsev::Dictionary::const_iterator end, const std::string& prefix,
       std::vector< std::pair< std::string, mezentsev::Translations > >& result)
@@ -471,8 +648,29 @@ void mezentsev::suggestCommand(DictionarySet& dicts, const std::vector< std::str
   std::string prefix = tokens[2];
   int n = std::stoi(tokens[3]);
   std::vector< std::string > suggestions;
-  auto it = dict.lower_bound(prefix);
-  collectSuggestions(dict, it, prefix, n, suggestions);
+  if (tokens.size() == 4)
+  {
+    auto it = dict.lower_bound(prefix);
+    collectSuggestions(dict, it, prefix, n, suggestions);
+  }
+  else if (tokens[4] == "ranked" || tokens[4] == "fuzzy")
+  {
+    TopSuggestions top{ static_cast< size_t >(std::max(n, 0)), {} };
+    if (tokens[4] == "ranked")
+    {
+      collectRankedSuggestions(dict.lower_bound(prefix), prefixEnd(dict, prefix), top);
+    }
+    else
+    {
+      collectFuzzySuggestions(dict, prefix, 0, 2, top);
+    }
+    std::transform(top.best.begin(), top.best.end(), std::back_inserter(suggestions), SuggestionWord());
+  }
+  else
+  {
+    std::cout << "INVALID COMMAND" << std::endl;
+    return;
+  }
   suggestions.resize(n, "<EMPTY>");
   std::copy(suggestions.begin(), suggestions.end(), std::ostream_iterator< std::string >(std::cout, "\n"));
 }
@@ -94,19 +94,19 @@ void rychkov::entities::remove_bridge(Expression& expr)
   {
     return;
   }
-  if (!boost::variant2::holds_alternative< DynMemWrapper< Expression > >(expr.operands[0]))
+  if (!boost::variant2::holds_alternative< NodeRef< Expression > >(expr.operands[0]))
   {
     return;
   }
-  Expression temp = std::move(*boost::variant2::get< DynMemWrapper< Expression > >(expr.operands[0]));
+  Expression temp = std::move(*boost::variant2::get< NodeRef< Expression > >(expr.operands[0]));
   expr = std::move(temp);
 }
 
 const rychkov::typing::Type* rychkov::entities::get_type(const Expression::operand& operand)
 {
-  if (boost::variant2::holds_alternative< DynMemWrapper< Expression > >(operand))
+  if (boost::variant2::holds_alternative< NodeRef< Expression > >(operand))
   {
-    return &boost::variant2::get< DynMemWrapper< Expression > >(operand)->result_type;
+    return &boost::variant2::get< NodeRef< Expression > >(operand)->result_type;
   }
   else if (boost::variant2::holds_alternative< Variable >(operand))
   {
@@ -124,9 +124,9 @@ const rychkov::typing::Type* rychkov::entities::get_type(const Expression::opera
 }
 bool rychkov::entities::is_lvalue(const Expression::operand& operand)
 {
-  if (boost::variant2::holds_alternative< DynMemWrapper< Expression > >(operand))
+  if (boost::variant2::holds_alternative< NodeRef< Expression > >(operand))
   {
-    return is_lvalue(&*boost::variant2::get< DynMemWrapper< Expression > >(operand));
+    return is_lvalue(&*boost::variant2::get< NodeRef< Expression > >(operand));
   }
   return boost::variant2::holds_alternative< entities::Variable >(operand);
 }
@@ -10,6 +10,7 @@
 #include <boost/variant2.hpp>
 #include <utility>
 #include "compare.hpp"
+#include "node_arena.hpp"
 
 namespace rychkov
 {
@@ -223,14 +224,14 @@ namespace rychkov
     {
       using declared = boost::variant2::variant< Variable, Struct, Enum, Union, Alias, Function, Statement >;
       declared data;
-      DynMemWrapper< Expression > value = nullptr;
+      NodeRef< Expression > value = nullptr;
       ScopeType scope = UNSPECIFIED;
     };
     struct CastOperation
     {
       typing::Type to;
       bool is_explicit = false;
-      DynMemWrapper< Expression > expr;
+      NodeRef< Expression > expr = nullptr;
     };
     struct Literal
     {
@@ -248,7 +249,7 @@ namespace rychkov
     };
     struct Expression
     {
-      using operand = boost::variant2::variant< DynMemWrapper< Expression >, Variable,
+      using operand = boost::variant2::variant< NodeRef< Expression >, Variable,
             Declaration, Literal, CastOperation, Body >;
 
       const Operator* operation;
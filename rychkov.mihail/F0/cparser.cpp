@@ -9,6 +9,7 @@
 using namespace std::literals::string_literals;
 
 rychkov::CParser::CParser():
+  nodes_{std::make_shared< node_arena >()},
   program_{{}}
 {
   stack_.push(&program_[0]);
@@ -33,14 +34,45 @@ void rychkov::CParser::prepare_type()
 void rychkov::CParser::clear_program()
 {
   program_ = {{}};
+  nodes_ = std::make_shared< node_arena >();
   stack_ = {};
   stack_.push(&program_[0]);
   type_parser_.clear();
 }
+void rychkov::CParser::assign(std::vector< entities::Expression > program, std::shared_ptr< node_arena > nodes)
+{
+  nodes_ = std::move(nodes);
+  program_ = std::move(program);
+  if (program_.empty())
+  {
+    program_.emplace_back();
+  }
+  stack_ = {};
+  stack_.push(&program_.back());
+  type_parser_.clear();
+}
+void rychkov::CParser::inherit_symbols(const CParser& src)
+{
+  aliases = src.aliases;
+  variables = src.variables;
+  structs = src.structs;
+  enums = src.enums;
+  unions = src.unions;
+  scope_logs_.clear();
+  log_scopes(base_types, &ScopeLog::base_types);
+  log_scopes(variables, &ScopeLog::variables);
+  log_scopes(structs, &ScopeLog::structs);
+  log_scopes(unions, &ScopeLog::unions);
+  log_scopes(enums, &ScopeLog::enums);
+}
 void rychkov::CParser::push_back(entities::Expression expr)
 {
   program_.push_back(std::move(expr));
 }
+rychkov::entities::Expression* rychkov::CParser::make_node(entities::Expression expr)
+{
+  return nodes_->make(std::move(expr));
+}
 
 const rychkov::Operator rychkov::CParser::parentheses = {Operator::MULTIPLE, Operator::SPECIAL,
     "()", false, false, false, 1};
@@ -219,7 +251,7 @@ bool rychkov::CParser::flush_type_parser(CParseContext& context)
         return false;
       }
       *stack_.top() = entities::Declaration{type_parser_.function()};
-      variables.insert({type_parser_.variable(), stack_.size()});
+      declare(variables, &ScopeLog::variables, {type_parser_.variable(), stack_.size()});
     }
     else
     {
@@ -236,7 +268,7 @@ bool rychkov::CParser::flush_type_parser(CParseContext& context)
         return false;
       }
       *stack_.top() = entities::Declaration{type_parser_.variable()};
-      variables.insert({type_parser_.variable(), stack_.size()});
+      declare(variables, &ScopeLog::variables, {type_parser_.variable(), stack_.size()});
     }
   }
   type_parser_.clear();
@@ -3,14 +3,17 @@
 
 #include <cstddef>
 #include <iosfwd>
+#include <iterator>
 #include <string>
 #include <set>
 #include <map>
+#include <memory>
 #include <vector>
 #include <utility>
 
 #include "type_parser.hpp"
 #include "content.hpp"
+#include "node_arena.hpp"
 #include "compare.hpp"
 #include "log.hpp"
 
@@ -28,6 +31,7 @@ namespace rychkov
       LONG
     };
     using value_type = entities::Expression;
+    using node_arena = NodeArena< entities::Expression >;
 
     static const Operator parentheses;
     static const Operator brackets;
@@ -61,7 +65,10 @@ namespace rychkov
     const TypeParser& next() const;
     void prepare_type();
     void clear_program();
+    void assign(std::vector< entities::Expression > program, std::shared_ptr< node_arena > nodes);
+    void inherit_symbols(const CParser& src);
     void push_back(entities::Expression expr);
+    entities::Expression* make_node(entities::Expression expr = {});
 
     void append(CParseContext& context, char c);
     void append(CParseContext& context, entities::Literal literal);
@@ -83,6 +90,16 @@ namespace rychkov
   private:
     static constexpr int min_priority = -1;
 
+    struct ScopeLog
+    {
+      std::vector< std::string > variables;
+      std::vector< std::string > structs;
+      std::vector< std::string > unions;
+      std::vector< std::string > enums;
+      std::vector< std::string > base_types;
+    };
+    using scope_names = std::vector< std::string > ScopeLog::*;
+
     const std::map< TypeKeyword, void(TypeParser::*)(CParseContext&) > type_keywords = {
           {CONST, &TypeParser::append_const},
           {VOLATILE, &TypeParser::append_volatile},
@@ -91,9 +108,11 @@ namespace rychkov
           {LONG, &TypeParser::append_long}
         };
 
+    std::shared_ptr< node_arena > nodes_;
     std::vector< entities::Expression > program_;
     std::stack< entities::Expression* > stack_;
     TypeParser type_parser_;
+    std::vector< ScopeLog > scope_logs_;
 
     bool global_scope() const noexcept;
 
@@ -104,6 +123,12 @@ namespace rychkov
     void move_up_down();
     void fold(CParseContext& context, const Operator* reference = nullptr);
     void clear_scope();
+    template< class T >
+    void declare(T& pair_set, scope_names log, typename T::value_type entry);
+    template< class T >
+    void log_scopes(const T& pair_set, scope_names log);
+    template< class T >
+    static void undo_scope(T& pair_set, const std::vector< std::string >& names, size_t scope);
     void calculate_type(CParseContext& context, entities::Expression& expr);
     void require_type(CParseContext& context, entities::Expression::operand& expr, const typing::Type& type);
     void require_type(CParseContext& context, entities::Expression& expr, const typing::Type& type);
@@ -148,5 +173,44 @@ void rychkov::CParser::clear_scope(T& pair_set, size_t scope)
     pos = pair_set.erase(pos, to);
   }
 }
+template< class T >
+void rychkov::CParser::declare(T& pair_set, scope_names log, typename T::value_type entry)
+{
+  size_t scope = entry.second;
+  std::string name = entities::get_name(entry.first);
+  pair_set.insert(std::move(entry));
+  if (scope >= scope_logs_.size())
+  {
+    scope_logs_.resize(scope + 1);
+  }
+  (scope_logs_[scope].*log).push_back(std::move(name));
+}
+template< class T >
+void rychkov::CParser::log_scopes(const T& pair_set, scope_names log)
+{
+  for (const typename T::value_type& entry: pair_set)
+  {
+    if (entry.second > 1)
+    {
+      if (entry.second >= scope_logs_.size())
+      {
+        scope_logs_.resize(entry.second + 1);
+      }
+      (scope_logs_[entry.second].*log).push_back(entities::get_name(entry.first));
+    }
+  }
+}
+template< class T >
+void rychkov::CParser::undo_scope(T& pair_set, const std::vector< std::string >& names, size_t scope)
+{
+  for (const std::string& name: names)
+  {
+    std::pair< typename T::iterator, typename T::iterator > range = pair_set.equal_range(name);
+    while (range.first != range.second)
+    {
+      range.first = range.first->second == scope ? pair_set.erase(range.first) : std::next(range.first);
+    }
+  }
+}
 
 #endif
@@ -0,0 +1,199 @@
+#include "include_cache.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <cctype>
+#include <utility>
+#include <functional>
+
+namespace
+{
+  constexpr const char* blanks = " \t\v\f\r\n";
+
+  bool is_name_char(char c)
+  {
+    return std::isalnum(c) || (c == '_');
+  }
+  std::string::size_type skip_spaces(const std::string& line, std::string::size_type pos)
+  {
+    for (; (pos < line.length()) && ((line[pos] == ' ') || (line[pos] == '\t')); pos++)
+    {}
+    return pos;
+  }
+  bool is_conditional(const std::string& cmd)
+  {
+    return (cmd == "if") || (cmd == "ifdef") || (cmd == "ifndef") || (cmd == "else") || (cmd == "elif")
+        || (cmd == "endif");
+  }
+  bool read_guard_open(const std::string& line, std::string& guard)
+  {
+    const std::string cmd = "#ifndef";
+    if (line.compare(0, cmd.length(), cmd) != 0)
+    {
+      return false;
+    }
+    std::string::size_type from = skip_spaces(line, cmd.length());
+    if (from == cmd.length())
+    {
+      return false;
+    }
+    std::string::size_type to = from;
+    for (; (to < line.length()) && is_name_char(line[to]); to++)
+    {}
+    if ((to == from) || (skip_spaces(line, to) != line.length()))
+    {
+      return false;
+    }
+    guard = line.substr(from, to - from);
+    return true;
+  }
+  bool is_guard_close(const std::string& line)
+  {
+    const std::string cmd = "#endif";
+    std::string::size_type from = skip_spaces(line, 0);
+    return (line.compare(from, cmd.length(), cmd) == 0)
+        && (line.find_first_not_of(blanks, from + cmd.length()) == std::string::npos);
+  }
+  bool scan_body_line(const std::string& line, bool& in_comment)
+  {
+    bool line_start = true;
+    for (std::string::size_type i = 0; i < line.length();)
+    {
+      if (in_comment)
+      {
+        std::string::size_type end = line.find("*/", i);
+        in_comment = (end == std::string::npos);
+        i = (in_comment ? line.length() : end + 2);
+        continue;
+      }
+      char c = line[i];
+      char next = (i + 1 < line.length() ? line[i + 1] : '\0');
+      if (std::isspace(c))
+      {
+        i++;
+      }
+      else if ((c == '/') && (next == '/'))
+      {
+        return true;
+      }
+      else if ((c == '/') && (next == '*'))
+      {
+        in_comment = true;
+        i += 2;
+      }
+      else if (line_start && (c == '#'))
+      {
+        std::string::size_type to = ++i;
+        for (; (to < line.length()) && is_name_char(line[to]); to++)
+        {}
+        if (is_conditional(line.substr(i, to - i)))
+        {
+          return false;
+        }
+        line_start = false;
+      }
+      else if ((c == '"') || (c == '\''))
+      {
+        for (i++; (i < line.length()) && (line[i] != c); i++)
+        {
+          if (line[i] == '\\')
+          {
+            i++;
+          }
+        }
+        if (i >= line.length())
+        {
+          return false;
+        }
+        i++;
+        line_start = false;
+      }
+      else
+      {
+        i++;
+        line_start = false;
+      }
+    }
+    return true;
+  }
+
+  // Recognises "#ifndef X ... #endif" spanning the whole file, with no other
+  // conditional directives inside. When X is already defined the preprocessor
+  // would emit nothing but the whitespace around the pair, so that is all
+  // a repeated #include has to replay. Anything unusual leaves guard empty.
+  void find_guard(rychkov::IncludedFile& file)
+  {
+    const std::string& text = file.text;
+    std::string::size_type open = text.find_first_not_of(blanks);
+    if ((open == std::string::npos) || (text[open] != '#') || (text.rfind('\n', open) == std::string::npos))
+    {
+      return;
+    }
+    std::string::size_type open_end = text.find('\n', open);
+    std::string::size_type last = text.find_last_not_of(blanks);
+    std::string::size_type close = text.rfind('\n', last);
+    std::string::size_type close_end = text.find('\n', last);
+    if ((open_end == std::string::npos) || (close == std::string::npos) || (close < open_end)
+        || (close_end == std::string::npos))
+    {
+      return;
+    }
+    std::string guard;
+    if (!read_guard_open(text.substr(open, open_end - open), guard)
+        || !is_guard_close(text.substr(close + 1, close_end - close - 1)))
+    {
+      return;
+    }
+    std::istringstream body(text.substr(open_end + 1, close - open_end));
+    bool in_comment = false;
+    std::string line;
+    while (std::getline(body, line))
+    {
+      if ((!line.empty() && ((line.back() == '\\') || ((line.back() == '\r') && (line.length() > 1)
+          && (line[line.length() - 2] == '\\')))) || !scan_body_line(line, in_comment))
+      {
+        return;
+      }
+    }
+    if (in_comment)
+    {
+      return;
+    }
+    file.guard = std::move(guard);
+    file.reentry = text.substr(0, open) + text.substr(close_end);
+  }
+}
+
+std::shared_ptr< const rychkov::IncludedFile > rychkov::IncludeCache::read(const std::string& path)
+{
+  std::ifstream in(path);
+  if (!in)
+  {
+    return nullptr;
+  }
+  std::ostringstream text;
+  text << in.rdbuf();
+  std::shared_ptr< IncludedFile > file = std::make_shared< IncludedFile >();
+  file->text = text.str();
+  file->hash = std::hash< std::string >{}(file->text);
+  find_guard(*file);
+  return file;
+}
+std::shared_ptr< const rychkov::IncludedFile > rychkov::IncludeCache::get(const std::string& path)
+{
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    decltype(files_)::const_iterator found = files_.find(path);
+    if (found != files_.cend())
+    {
+      return found->second;
+    }
+  }
+  std::shared_ptr< const IncludedFile > file = read(path);
+  if (file != nullptr)
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    file = files_.emplace(path, std::move(file)).first->second;
+  }
+  return file;
+}
@@ -0,0 +1,31 @@
+#ifndef INCLUDE_CACHE_HPP
+#define INCLUDE_CACHE_HPP
+
+#include <cstddef>
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace rychkov
+{
+  struct IncludedFile
+  {
+    std::string text;
+    size_t hash = 0;
+    std::string guard;
+    std::string reentry;
+  };
+  class IncludeCache
+  {
+  public:
+    static std::shared_ptr< const IncludedFile > read(const std::string& path);
+    std::shared_ptr< const IncludedFile > get(const std::string& path);
+
+  private:
+    std::mutex mutex_;
+    std::map< std::string, std::shared_ptr< const IncludedFile > > files_;
+  };
+}
+
+#endif
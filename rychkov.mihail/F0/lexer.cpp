@@ -3,25 +3,12 @@
 #include <iostream>
 #include <cctype>
 #include <utility>
+#include <array>
 #include "cparser.hpp"
 #include "print_content.hpp"
 
 rychkov::Lexer::Lexer(std::unique_ptr< CParser > cparser):
-  next{std::move(cparser)},
-  type_keywords_{
-        {"const", CParser::CONST},
-        {"volatile", CParser::VOLATILE},
-        {"signed", CParser::SIGNED},
-        {"unsigned", CParser::UNSIGNED},
-        {"long", CParser::LONG}
-      },
-  keywords_{
-        {"typedef", &CParser::parse_typedef},
-        {"struct", &CParser::parse_struct},
-        {"return", &CParser::parse_return},
-        {"if", &CParser::parse_if},
-        {"while", &CParser::parse_while}
-      }
+  next{std::move(cparser)}
 {}
 
 const std::set< std::vector< rychkov::Operator >, rychkov::NameCompare > rychkov::Lexer::cases{
@@ -80,32 +67,94 @@ const std::set< std::vector< rychkov::Operator >, rychkov::NameCompare > rychkov
       {{rychkov::Operator::BINARY, rychkov::Operator::ASSIGN, "=", true, true, true, 14}}
     };
 
-void rychkov::Lexer::append_name(CParseContext& context, std::string name)
+namespace
 {
-  flush(context);
-  decltype(type_keywords_)::const_iterator type_keyword_p = type_keywords_.find(name);
-  if (type_keyword_p != type_keywords_.end())
+  using operator_cases = std::vector< rychkov::Operator >;
+
+  struct Keyword
   {
-    if (next == nullptr)
+    const char* name = nullptr;
+    bool is_type = false;
+    rychkov::CParser::TypeKeyword type = rychkov::CParser::CONST;
+    void(rychkov::CParser::*parse)(rychkov::CParseContext&) = nullptr;
+  };
+
+  // (length + first + 5 * last) % 32 has no collisions on the keywords below
+  constexpr size_t keyword_table_size = 32;
+  size_t keyword_hash(const std::string& name)
+  {
+    return (name.length() + static_cast< unsigned char >(name.front())
+        + 5 * static_cast< unsigned char >(name.back())) % keyword_table_size;
+  }
+  std::array< Keyword, keyword_table_size > make_keywords()
+  {
+    const Keyword keywords[] = {
+          {"const", true, rychkov::CParser::CONST},
+          {"volatile", true, rychkov::CParser::VOLATILE},
+          {"signed", true, rychkov::CParser::SIGNED},
+          {"unsigned", true, rychkov::CParser::UNSIGNED},
+          {"long", true, rychkov::CParser::LONG},
+          {"typedef", false, rychkov::CParser::CONST, &rychkov::CParser::parse_typedef},
+          {"struct", false, rychkov::CParser::CONST, &rychkov::CParser::parse_struct},
+          {"return", false, rychkov::CParser::CONST, &rychkov::CParser::parse_return},
+          {"if", false, rychkov::CParser::CONST, &rychkov::CParser::parse_if},
+          {"while", false, rychkov::CParser::CONST, &rychkov::CParser::parse_while}
+        };
+    std::array< Keyword, keyword_table_size > result{};
+    for (const Keyword& keyword: keywords)
     {
-      context.out << "<keyw> " << name << '\n';
+      result[keyword_hash(keyword.name)] = keyword;
     }
-    else
+    return result;
+  }
+  std::array< const operator_cases*, 256 > make_single_char_operators()
+  {
+    std::array< const operator_cases*, 256 > result{};
+    for (const operator_cases& oper: rychkov::Lexer::cases)
     {
-      next->append(context, type_keyword_p->second);
+      if (oper[0].token.length() == 1)
+      {
+        result[static_cast< unsigned char >(oper[0].token[0])] = &oper;
+      }
     }
-    return;
+    return result;
+  }
+
+  const std::array< Keyword, keyword_table_size > keywords = make_keywords();
+  const std::array< const operator_cases*, 256 > single_char_operators = make_single_char_operators();
+
+  const Keyword* find_keyword(const std::string& name)
+  {
+    if (name.empty())
+    {
+      return nullptr;
+    }
+    const Keyword& keyword = keywords[keyword_hash(name)];
+    return (keyword.name != nullptr) && (name == keyword.name) ? &keyword : nullptr;
   }
-  decltype(keywords_)::const_iterator keyword_p = keywords_.find(name);
-  if (keyword_p != keywords_.cend())
+  const operator_cases* find_operator(char c)
+  {
+    return single_char_operators[static_cast< unsigned char >(c)];
+  }
+}
+
+void rychkov::Lexer::append_name(CParseContext& context, std::string name)
+{
+  flush(context);
+  const Keyword* keyword = find_keyword(name);
+  if (keyword != nullptr)
   {
     if (next == nullptr)
     {
       context.out << "<keyw> " << name << '\n';
     }
+    else if (keyword->is_type)
+    {
+      next->append(context, keyword->type);
+    }
     else
     {
-      ((*next).*(keyword_p->second))(context);
+      ((*next).*(keyword->parse))(context);
     }
     return;
   }
@@ -264,10 +313,10 @@ void rychkov::Lexer::append(CParseContext& context, char c)
 }
 void rychkov::Lexer::append_new(CParseContext& context, char c)
 {
-  decltype(cases)::const_iterator oper_p = cases.find(std::string{c});
-  if (oper_p != cases.end())
+  const operator_cases* oper = find_operator(c);
+  if (oper != nullptr)
   {
-    buf_ = &*oper_p;
+    buf_ = oper;
   }
   else if (!std::isspace(c))
   {
@@ -281,12 +330,15 @@ void rychkov::Lexer::append_new(CParseContext& context, char c)
 }
 void rychkov::Lexer::append_operator(CParseContext& context, char c)
 {
-  operator_value& oper = boost::variant2::get< operator_value >(buf_);
-  decltype(cases)::const_iterator oper_p = cases.find((*oper)[0].token + c);
-  if (oper_p != cases.cend())
+  if (find_operator(c) != nullptr)
   {
-    buf_ = &*oper_p;
-    return;
+    operator_value& oper = boost::variant2::get< operator_value >(buf_);
+    decltype(cases)::const_iterator oper_p = cases.find((*oper)[0].token + c);
+    if (oper_p != cases.cend())
+    {
+      buf_ = &*oper_p;
+      return;
+    }
   }
   flush(context);
   append(context, c);
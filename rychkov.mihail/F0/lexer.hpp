@@ -3,7 +3,6 @@
 
 #include <string>
 #include <set>
-#include <map>
 #include <vector>
 #include <memory>
 #include <boost/variant2.hpp>
@@ -33,9 +32,6 @@ namespace rychkov
   private:
     using operator_value = const std::vector< Operator >*;
 
-    const std::map< std::string, CParser::TypeKeyword > type_keywords_;
-    const std::map< std::string, void(CParser::*)(CParseContext&) > keywords_;
-
     boost::variant2::variant< boost::variant2::monostate, operator_value, entities::Literal > buf_;
 
     void append_new(CParseContext& context, char c);
@@ -6,6 +6,8 @@
 #include <cctype>
 #include <utility>
 #include <algorithm>
+#include <future>
+#include <thread>
 
 rychkov::Parser::map_type< rychkov::ParserContext, rychkov::MainProcessor > rychkov::MainProcessor::call_map = {
       {"save", &rychkov::MainProcessor::save},
@@ -33,13 +35,110 @@ rychkov::ParseCell::ParseCell(CParseContext context, Stage last_stage,
       std::move(include_dirs)}
 {}
 bool rychkov::ParseCell::parse(std::istream& in)
+{
+  return parse(in, base_context.out, base_context.err);
+}
+bool rychkov::ParseCell::parse(std::istream& in, std::ostream& out, std::ostream& err)
 {
   std::stringstream cache_stream;
   cache_stream << in.rdbuf();
   cache = cache_stream.str();
-  preproc.parse(base_context, cache_stream);
+  cache_hash = std::hash< std::string >{}(cache);
+  tracked = true;
+  symbols = nullptr;
+  CParseContext context{out, err, base_context.file};
+  preproc.parse(context, cache_stream);
+  base_context.line = context.line;
+  base_context.symbol = context.symbol;
+  base_context.last_line = std::move(context.last_line);
+  base_context.nerrors += context.nerrors;
   return base_context.nerrors == 0;
 }
+const rychkov::SymbolIndex& rychkov::ParseCell::index()
+{
+  if (symbols == nullptr)
+  {
+    symbols = std::make_shared< const SymbolIndex >(*preproc.next->next);
+  }
+  return *symbols;
+}
+bool rychkov::ParseCell::unchanged(IncludeCache& files) const
+{
+  if (!tracked)
+  {
+    return false;
+  }
+  std::shared_ptr< const IncludedFile > source = files.get(base_context.file);
+  if ((source == nullptr) || (source->hash != cache_hash))
+  {
+    return false;
+  }
+  for (const std::pair< const std::string, size_t >& header: preproc.included_files)
+  {
+    std::shared_ptr< const IncludedFile > file = files.get(header.first);
+    if ((file == nullptr) || (file->hash != header.second))
+    {
+      return false;
+    }
+  }
+  for (const std::string& path: preproc.missing_files)
+  {
+    if (files.get(path) != nullptr)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+rychkov::ParseJob::ParseJob(ParseCell new_cell):
+  cell{std::move(new_cell)}
+{}
+namespace
+{
+  void parse_job_range(rychkov::ParseJob* first, rychkov::ParseJob* last)
+  {
+    for (; first != last; ++first)
+    {
+      std::ifstream in(first->cell.base_context.file);
+      first->opened = static_cast< bool >(in);
+      first->parsed = first->cell.parse(in, first->out, first->err);
+    }
+  }
+}
+void rychkov::parse_jobs(std::vector< ParseJob >& jobs, std::shared_ptr< IncludeCache > include_cache)
+{
+  size_t nthreads = std::max(std::thread::hardware_concurrency(), 1U);
+  size_t chunk_size = (jobs.size() + nthreads - 1) / nthreads;
+  if (chunk_size == 0)
+  {
+    return;
+  }
+  if (include_cache == nullptr)
+  {
+    include_cache = std::make_shared< IncludeCache >();
+  }
+  for (ParseJob& job: jobs)
+  {
+    job.cell.preproc.include_cache = include_cache;
+  }
+  ParseJob* data = jobs.data();
+  std::vector< std::future< void > > tasks;
+  for (size_t from = chunk_size; from < jobs.size(); from += chunk_size)
+  {
+    size_t to = std::min(from + chunk_size, jobs.size());
+    tasks.push_back(std::async(std::launch::async, parse_job_range, data + from, data + to));
+  }
+  parse_job_range(data, data + std::min(chunk_size, jobs.size()));
+  for (std::future< void >& task: tasks)
+  {
+    task.get();
+  }
+  for (ParseJob& job: jobs)
+  {
+    job.cell.preproc.include_cache = nullptr;
+  }
+}
 
 bool rychkov::MainProcessor::parse(ParserContext& context)
 {
@@ -72,30 +171,62 @@ bool rychkov::MainProcessor::reload(ParserContext& context)
   {
     return false;
   }
-  std::map< std::string, ParseCell > new_parsed;
-  for (const std::pair< const std::string, ParseCell >& file: parsed_)
+  std::shared_ptr< IncludeCache > files = std::make_shared< IncludeCache >();
+  std::vector< ParseJob > jobs;
+  std::vector< ParseCell* > order;
+  size_t nreused = 0;
+  for (std::pair< const std::string, ParseCell >& file: parsed_)
   {
     if (!file.second.real_file)
     {
       continue;
     }
-    std::ifstream in(file.first);
-    if (!in)
+    if ((last_stage_ == CPARSER) && file.second.unchanged(*files))
+    {
+      order.push_back(&file.second);
+      nreused++;
+    }
+    else
+    {
+      order.push_back(nullptr);
+      jobs.emplace_back(ParseCell{{context.out, context.err, file.first}, last_stage_, include_dirs_});
+    }
+  }
+  parse_jobs(jobs, files);
+  std::map< std::string, ParseCell > new_parsed;
+  std::vector< ParseJob >::iterator job_p = jobs.begin();
+  for (ParseCell* reused: order)
+  {
+    if (reused != nullptr)
+    {
+      context.out << "<--PARSE: \"" << reused->base_context.file << "\"-->\n";
+      continue;
+    }
+    ParseJob& job = *job_p++;
+    const std::string& filename = job.cell.base_context.file;
+    if (!job.opened)
     {
-      context.err << "failed to reopen source file: \"" << file.first << "\"\n";
+      context.err << "failed to reopen source file: \"" << filename << "\"\n";
     }
-    std::pair< decltype(new_parsed)::iterator, bool > cell_p = new_parsed.emplace(file.first,
-          ParseCell{{context.out, context.err, file.first}, last_stage_, include_dirs_});
-    if (cell_p.second)
+    context.out << "<--PARSE: \"" << filename << "\"-->\n";
+    context.out << job.out.str();
+    context.err << job.err.str();
+    if (!job.parsed)
     {
-      context.out << "<--PARSE: \"" << file.first << "\"-->\n";
-      if (!cell_p.first->second.parse(in))
-      {
-        context.err << "failed to parse file \"" << file.first << "\" - stopping\n";
-        return true;
-      }
+      context.err << "failed to parse file \"" << filename << "\" - stopping\n";
+      return true;
+    }
+    new_parsed.emplace(filename, std::move(job.cell));
+  }
+  for (ParseCell* reused: order)
+  {
+    if (reused != nullptr)
+    {
+      std::string filename = reused->base_context.file;
+      new_parsed.emplace(std::move(filename), std::move(*reused));
     }
   }
+  context.out << "<--REUSED: " << nreused << '/' << order.size() << "-->\n";
   context.out << "<--DONE-->\n";
   parsed_ = std::move(new_parsed);
   generated_files = 0;
@@ -115,12 +246,7 @@ bool rychkov::MainProcessor::parse_after(ParserContext& context)
     {
       return false;
     }
-    CParser& dest_parser = *cell.preproc.next->next;
-    dest_parser.aliases = src_parser.aliases;
-    dest_parser.variables = src_parser.variables;
-    dest_parser.structs = src_parser.structs;
-    dest_parser.enums = src_parser.enums;
-    dest_parser.unions = src_parser.unions;
+    cell.preproc.next->next->inherit_symbols(src_parser);
   }
   while (context.in.good())
   {
@@ -1,15 +1,20 @@
 #ifndef PROCESSORS_HPP
 #define PROCESSORS_HPP
 
+#include <cstddef>
 #include <iosfwd>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
+#include <utility>
 
 #include <parser.hpp>
 
 #include "log.hpp"
 #include "preprocessor.hpp"
+#include "symbol_index.hpp"
 
 namespace rychkov
 {
@@ -23,11 +28,33 @@ namespace rychkov
   {
     ParseCell(CParseContext context, Stage last_stage, std::vector< std::string > include_dirs);
     bool parse(std::istream& in);
+    bool parse(std::istream& in, std::ostream& out, std::ostream& err);
+    bool unchanged(IncludeCache& files) const;
+    const SymbolIndex& index();
     CParseContext base_context;
     Preprocessor preproc;
     bool real_file = true;
+    bool tracked = false;
+    size_t cache_hash = 0;
     std::string cache;
+    std::shared_ptr< const SymbolIndex > symbols;
   };
+  struct CrossIndex
+  {
+    std::vector< std::pair< std::string, std::shared_ptr< const SymbolIndex > > > cells;
+    std::multimap< entities::Variable, std::vector< std::string >, NameCompare > appearances;
+    std::multimap< Macro, std::vector< std::string >, NameCompare > macros;
+  };
+  struct ParseJob
+  {
+    ParseJob(ParseCell new_cell);
+    ParseCell cell;
+    std::ostringstream out;
+    std::ostringstream err;
+    bool opened = false;
+    bool parsed = false;
+  };
+  void parse_jobs(std::vector< ParseJob >& jobs, std::shared_ptr< IncludeCache > include_cache = nullptr);
 
   class MainProcessor
   {
@@ -36,7 +63,6 @@ namespace rychkov
     static Parser::map_type< ParserContext, MainProcessor > call_map;
 
     void help(std::ostream& out);
-    bool parse(CParseContext file_context, bool overwrite);
     bool load(std::ostream& out, std::ostream& err, std::string filename);
     bool save(std::ostream& err, std::string filename) const;
 
@@ -60,11 +86,19 @@ namespace rychkov
     bool unopen_defines(ParserContext& context);
 
   private:
+    static constexpr const char* snapshot_ext = ".snap";
+
     Stage last_stage_ = CPARSER;
     std::vector< std::string > include_dirs_;
     std::map< std::string, ParseCell > parsed_;
     std::string save_file_ = "save.json";
     size_t generated_files = 0;
+    CrossIndex cross_index_;
+
+    static bool is_snapshot(const std::string& filename);
+    bool save_snapshot(std::ostream& err, const std::string& filename) const;
+    bool load_snapshot(std::ostream& out, std::ostream& err, const std::string& filename);
+    const CrossIndex& cross_index();
   };
 }
 
@@ -13,8 +13,7 @@ namespace rychkov
   struct DiffVisitor
   {
     std::set< std::string > files;
-    std::multimap< entities::Variable, std::vector< std::string >, NameCompare > appearances;
-    std::multimap< Macro, std::vector< std::string >, NameCompare > macros;
+    CrossIndex index;
     std::string current_file;
 
     void operator()(const std::pair< const std::string, ParseCell >& cell)
@@ -49,8 +48,8 @@ namespace rychkov
     }
     void operator()(const entities::Variable& var)
     {
-      using Iter = decltype(appearances)::iterator;
-      std::pair< Iter, Iter > range = appearances.equal_range(var);
+      using Iter = decltype(index.appearances)::iterator;
+      std::pair< Iter, Iter > range = index.appearances.equal_range(var);
       for (; range.first != range.second; ++range.first)
       {
         if (var.name != range.first->first.name)
@@ -65,13 +64,13 @@ namespace rychkov
       }
       if (range.first == range.second)
       {
-        appearances.emplace(var, std::vector< std::string >{current_file});
+        index.appearances.emplace(var, std::vector< std::string >{current_file});
       }
     }
     void operator()(const Macro& macro)
     {
-      using Iter = decltype(macros)::iterator;
-      std::pair< Iter, Iter > range = macros.equal_range(macro);
+      using Iter = decltype(index.macros)::iterator;
+      std::pair< Iter, Iter > range = index.macros.equal_range(macro);
       for (; range.first != range.second; ++range.first)
       {
         const std::vector< std::string >& parameters = range.first->first.parameters;
@@ -92,21 +91,38 @@ namespace rychkov
       }
       if (range.first == range.second)
       {
-        macros.emplace(macro, std::vector< std::string >{current_file});
+        index.macros.emplace(macro, std::vector< std::string >{current_file});
       }
     }
   };
 }
 
+const rychkov::CrossIndex& rychkov::MainProcessor::cross_index()
+{
+  decltype(cross_index_.cells) cells;
+  cells.reserve(parsed_.size());
+  for (std::pair< const std::string, ParseCell >& cell: parsed_)
+  {
+    cell.second.index();
+    cells.emplace_back(cell.first, cell.second.symbols);
+  }
+  if (cells != cross_index_.cells)
+  {
+    cross_index_ = std::for_each(parsed_.begin(), parsed_.end(), DiffVisitor{}).index;
+    cross_index_.cells = std::move(cells);
+  }
+  return cross_index_;
+}
+
 bool rychkov::MainProcessor::intersections(ParserContext& context)
 {
   if ((last_stage_ != CPARSER) || !eol(context.in))
   {
     return false;
   }
-  DiffVisitor visitor = std::for_each(parsed_.begin(), parsed_.end(), DiffVisitor{});
+  const CrossIndex& index = cross_index();
   bool empty = true;
-  for (const decltype(visitor.appearances)::value_type& list: visitor.appearances)
+  for (const decltype(index.appearances)::value_type& list: index.appearances)
   {
     if (list.second.size() >= 2)
     {
@@ -115,7 +131,7 @@ bool rychkov::MainProcessor::intersections(ParserContext& context)
       std::for_each(list.second.begin(), list.second.end(), ContentPrinter{context.out, 1});
     }
   }
-  for (const decltype(visitor.macros)::value_type& list: visitor.macros)
+  for (const decltype(index.macros)::value_type& list: index.macros)
   {
     if (list.second.size() >= 2)
     {
@@ -143,13 +159,19 @@ bool rychkov::MainProcessor::diff(ParserContext& context)
     context.in >> name;
     files.insert(name);
   }
-  DiffVisitor visitor = std::for_each(parsed_.begin(), parsed_.end(), DiffVisitor{std::move(files)});
+  bool all_files = files.empty();
+  CrossIndex filtered;
+  if (!all_files)
+  {
+    filtered = std::for_each(parsed_.begin(), parsed_.end(), DiffVisitor{std::move(files)}).index;
+  }
+  const CrossIndex& index = all_files ? cross_index() : filtered;
   bool empty = true;
-  using MacroIter = decltype(visitor.macros)::const_iterator;
-  MacroIter i = visitor.macros.begin();
-  while (i != visitor.macros.end())
+  using MacroIter = decltype(index.macros)::const_iterator;
+  MacroIter i = index.macros.begin();
+  while (i != index.macros.end())
   {
-    MacroIter to = visitor.macros.upper_bound(i->first.name);
+    MacroIter to = index.macros.upper_bound(i->first.name);
     if (std::distance(i, to) > 1)
     {
       empty = false;
@@ -166,11 +188,11 @@ bool rychkov::MainProcessor::diff(ParserContext& context)
       ++i;
     }
   }
-  using VarIter = decltype(visitor.appearances)::const_iterator;
-  VarIter j = visitor.appearances.begin();
-  while (j != visitor.appearances.end())
+  using VarIter = decltype(index.appearances)::const_iterator;
+  VarIter j = index.appearances.begin();
+  while (j != index.appearances.end())
   {
-    VarIter to = visitor.appearances.upper_bound(j->first.name);
+    VarIter to = index.appearances.upper_bound(j->first.name);
     if (std::distance(j, to) > 1)
     {
       empty = false;
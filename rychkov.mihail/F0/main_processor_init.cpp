@@ -85,9 +85,18 @@ bool rychkov::MainProcessor::init(ParserContext& context, int argc, char** argv)
   std::sort(files.begin(), files.end());
   files.erase(std::unique(files.begin(), files.end()), files.end());
 
-  std::string ext = (last_stage_ == PREPROCESSOR ? ".i" : (last_stage_ == LEXER ? ".lex" : ".json"));
+  std::vector< ParseJob > jobs;
+  jobs.reserve(files.size());
   for (const std::string& filename: files)
   {
+    jobs.emplace_back(ParseCell{{context.out, context.err, filename}, last_stage_, include_dirs_});
+  }
+  parse_jobs(jobs);
+
+  std::string ext = (last_stage_ == PREPROCESSOR ? ".i" : (last_stage_ == LEXER ? ".lex" : ".json"));
+  for (ParseJob& job: jobs)
+  {
+    const std::string filename = job.cell.base_context.file;
     std::ostream* output = &context.out;
     std::ofstream ostream;
     std::string output_filename;
@@ -110,12 +119,19 @@ bool rychkov::MainProcessor::init(ParserContext& context, int argc, char** argv)
       }
       output = &ostream;
     }
-    CParseContext parse_context{*output, context.err, filename};
     context.out << "<--PARSE: \"" << filename << "\"-->\n";
-    if (!parse(parse_context, true))
+    if (!job.opened)
+    {
+      throw std::invalid_argument("failed to open source file: \"" + filename + '"');
+    }
+    *output << job.out.str();
+    context.err << job.err.str();
+    if (!job.parsed)
     {
       throw std::runtime_error("failed to parse file \"" + filename + "\" - stopping");
     }
+    parsed_.erase(filename);
+    parsed_.emplace(filename, std::move(job.cell));
     if (out && (last_stage_ == CPARSER))
     {
       save(context.err, output_filename);
@@ -125,23 +141,3 @@ bool rychkov::MainProcessor::init(ParserContext& context, int argc, char** argv)
   context.out << "<--DONE-->\n";
   return !out;
 }
-
-bool rychkov::MainProcessor::parse(CParseContext file_context, bool overwrite)
-{
-  if (overwrite)
-  {
-    parsed_.erase(file_context.file);
-  }
-  std::pair< decltype(parsed_)::iterator, bool > cell = parsed_.emplace(file_context.file,
-    ParseCell{file_context, last_stage_, include_dirs_});
-  if (!cell.second)
-  {
-    return true;
-  }
-  std::ifstream in(cell.first->first);
-  if (!in)
-  {
-    throw std::invalid_argument("failed to open source file: \"" + file_context.file + '"');
-  }
-  return cell.first->second.parse(in);
-}
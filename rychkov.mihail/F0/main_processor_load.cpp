@@ -40,6 +40,10 @@ namespace rychkov
 
 bool rychkov::MainProcessor::load(std::ostream& out, std::ostream& err, std::string filename)
 {
+  if (is_snapshot(filename))
+  {
+    return load_snapshot(out, err, filename);
+  }
   std::ifstream in(filename);
   if (!in)
   {
@@ -179,7 +183,7 @@ rychkov::entities::Expression rychkov::Loader::as_expr(const boost::json::value&
     result.operands.reserve(operands.size());
     for (const boost::json::value& operand: operands)
     {
-      result.operands.push_back(as_expr(operand));
+      result.operands.push_back(parser.make_node(as_expr(operand)));
     }
     return result;
   }
@@ -195,7 +199,7 @@ rychkov::entities::Expression::operand rychkov::Loader::as_operand(const boost::
   const boost::json::string& type = obj.at("obj").as_string();
   if (type == "expr")
   {
-    return as_expr(val);
+    return parser.make_node(as_expr(val));
   }
   else if (type == "var")
   {
@@ -346,7 +350,7 @@ rychkov::entities::Declaration rychkov::Loader::as_decl(const boost::json::value
     return result;
   }
   ++depth;
-  result.value = as_expr(obj.at("value"));
+  result.value = parser.make_node(as_expr(obj.at("value")));
   --depth;
   clear_scope();
   return result;
@@ -394,7 +398,8 @@ rychkov::entities::Declaration::declared rychkov::Loader::as_declared(const boos
 rychkov::entities::CastOperation rychkov::Loader::as_cast(const boost::json::value& val)
 {
   const boost::json::object& obj = val.as_object();
-  return {as_var_data(obj.at("to").as_string()).type, obj.at("explicit").as_bool(), as_expr(obj.at("value"))};
+  return {as_var_data(obj.at("to").as_string()).type, obj.at("explicit").as_bool(),
+        parser.make_node(as_expr(obj.at("value")))};
 }
 rychkov::entities::Body rychkov::Loader::as_body(const boost::json::value& val)
 {
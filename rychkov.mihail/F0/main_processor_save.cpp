@@ -26,7 +26,7 @@ namespace rychkov
     boost::json::value operator()(const entities::Literal& literal);
     boost::json::value operator()(const entities::CastOperation& cast);
 
-    boost::json::value operator()(const DynMemWrapper< entities::Expression >& root);
+    boost::json::value operator()(const NodeRef< entities::Expression >& root);
     boost::json::value operator()(const entities::Expression& root);
     boost::json::value operator()(const entities::Expression::operand& operand);
   };
@@ -34,6 +34,10 @@ namespace rychkov
 
 bool rychkov::MainProcessor::save(std::ostream& err, std::string filename) const
 {
+  if (is_snapshot(filename))
+  {
+    return save_snapshot(err, filename);
+  }
   std::ofstream out(filename);
   if (!out)
   {
@@ -148,7 +152,7 @@ boost::json::value rychkov::Serializer::operator()(const entities::Expression& e
         {"rallign", expr.operation->right_align}, {"size", expr.operation->type},
         {"operands", std::move(operands)}, {"res_t", operator()(expr.result_type)}};
 }
-boost::json::value rychkov::Serializer::operator()(const DynMemWrapper< entities::Expression >& ptr)
+boost::json::value rychkov::Serializer::operator()(const NodeRef< entities::Expression >& ptr)
 {
   return ptr != nullptr ? operator()(*ptr) : boost::json::value{};
 }
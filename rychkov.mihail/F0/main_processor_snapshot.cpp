@@ -0,0 +1,927 @@
+#include "main_processor.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace rychkov
+{
+  class SnapshotWriter
+  {
+  public:
+    static constexpr std::uint32_t none = UINT32_MAX;
+
+    std::string finish(const std::string& cells);
+
+    void put(std::string& out, std::uint8_t value);
+    void put(std::string& out, std::uint32_t value);
+    void put(std::string& out, std::uint64_t value);
+    std::uint32_t string_id(const std::string& str);
+    std::uint32_t type_id(const typing::Type& type);
+
+    void put_macro(std::string& out, const Macro& macro);
+    void put_variable(std::string& out, const entities::Variable& var);
+    void put_struct(std::string& out, const std::string& name,
+        const std::set< entities::Variable, NameCompare >& fields);
+    void put_enum(std::string& out, const entities::Enum& structure);
+
+    std::uint32_t operator()(const entities::Expression& expr);
+    std::uint32_t operator()(const NodeRef< entities::Expression >& expr);
+    std::uint32_t operator()(const entities::Variable& var);
+    std::uint32_t operator()(const entities::Declaration& decl);
+    std::uint32_t operator()(const entities::Literal& lit);
+    std::uint32_t operator()(const entities::CastOperation& cast);
+    std::uint32_t operator()(const entities::Body& body);
+
+  private:
+    std::string strings_, types_, nodes_;
+    std::uint32_t nstrings_ = 0, ntypes_ = 0, nnodes_ = 0;
+    std::unordered_map< std::string, std::uint32_t > string_ids_;
+    std::unordered_map< std::string, std::uint32_t > type_ids_;
+
+    std::uint32_t add_node(const std::string& record);
+    void put_declared(std::string& out, const entities::Declaration::declared& data);
+  };
+  class SnapshotReader
+  {
+  public:
+    explicit SnapshotReader(std::string data);
+
+    bool done() const noexcept;
+    std::uint8_t get_u8();
+    std::uint32_t get_u32();
+    std::uint64_t get_u64();
+    const std::string& get_string();
+    const typing::Type& get_type();
+
+    Macro get_macro();
+    entities::Variable get_variable();
+    std::set< entities::Variable, NameCompare > get_fields();
+    entities::Enum get_enum();
+    NodeRef< entities::Expression > take_node(std::uint32_t id);
+    entities::Expression take_expr(std::uint32_t id);
+    std::shared_ptr< CParser::node_arena > arena() const noexcept;
+
+  private:
+    std::string data_;
+    size_t pos_ = 0;
+    std::vector< std::string > strings_;
+    std::vector< typing::Type > types_;
+    std::shared_ptr< CParser::node_arena > arena_ = std::make_shared< CParser::node_arena >();
+    std::vector< entities::Expression::operand > nodes_;
+    std::vector< bool > taken_;
+
+    size_t get_count(size_t min_record_size);
+    entities::Expression::operand take_operand(std::uint32_t id);
+    void read_type();
+    void read_node();
+    entities::Declaration::declared get_declared();
+  };
+}
+
+namespace
+{
+  constexpr const char* snapshot_magic = "RYCSNAP1";
+  constexpr size_t snapshot_magic_size = 8;
+
+  enum NodeKind: std::uint8_t
+  {
+    EXPR_NODE,
+    VAR_NODE,
+    DECL_NODE,
+    LIT_NODE,
+    CAST_NODE,
+    BODY_NODE
+  };
+  enum DeclaredKind: std::uint8_t
+  {
+    DECLARED_VAR,
+    DECLARED_STRUCT,
+    DECLARED_ENUM,
+    DECLARED_UNION,
+    DECLARED_ALIAS,
+    DECLARED_FUNC,
+    DECLARED_STATEMENT
+  };
+  enum TypeFlags: std::uint8_t
+  {
+    TYPE_CONST = 1,
+    TYPE_VOLATILE = 2,
+    TYPE_SIGNED = 4,
+    TYPE_UNSIGNED = 8,
+    TYPE_HAS_LENGTH = 16
+  };
+
+  const rychkov::Operator* find_operator(const std::string& token, bool right_align, int type)
+  {
+    decltype(rychkov::Lexer::cases)::const_iterator cases = rychkov::Lexer::cases.find(token);
+    if (cases != rychkov::Lexer::cases.end())
+    {
+      const rychkov::Operator* result = nullptr;
+      for (const rychkov::Operator& i: *cases)
+      {
+        if ((i.right_align == right_align) && (i.type == type))
+        {
+          result = &i;
+        }
+      }
+      return result;
+    }
+    const rychkov::Operator* specials[] = {&rychkov::CParser::parentheses, &rychkov::CParser::brackets,
+          &rychkov::CParser::comma, &rychkov::CParser::inline_if};
+    for (const rychkov::Operator* special: specials)
+    {
+      if (special->token == token)
+      {
+        return special;
+      }
+    }
+    return nullptr;
+  }
+}
+
+bool rychkov::MainProcessor::is_snapshot(const std::string& filename)
+{
+  const std::string ext = snapshot_ext;
+  return (filename.length() > ext.length())
+      && (filename.compare(filename.length() - ext.length(), ext.length(), ext) == 0);
+}
+bool rychkov::MainProcessor::save_snapshot(std::ostream& err, const std::string& filename) const
+{
+  std::ofstream out(filename, std::ios::binary);
+  if (!out)
+  {
+    err << "failed to open save file on write - \"" << filename << "\"\n";
+    return false;
+  }
+  SnapshotWriter writer;
+  std::string cells;
+  writer.put(cells, static_cast< std::uint32_t >(parsed_.size()));
+  for (const std::pair< const std::string, ParseCell >& file: parsed_)
+  {
+    const Preprocessor& preproc = file.second.preproc;
+    const CParser& src = *preproc.next->next;
+    writer.put(cells, writer.string_id(file.first));
+    writer.put(cells, static_cast< std::uint8_t >(file.second.real_file));
+    writer.put(cells, writer.string_id(file.second.cache));
+
+    writer.put(cells, static_cast< std::uint32_t >(preproc.macros.size()));
+    for (const Macro& macro: preproc.macros)
+    {
+      writer.put_macro(cells, macro);
+    }
+    writer.put(cells, static_cast< std::uint32_t >(preproc.legacy_macros.size()));
+    for (const Macro& macro: preproc.legacy_macros)
+    {
+      writer.put_macro(cells, macro);
+    }
+    writer.put(cells, static_cast< std::uint32_t >(std::distance(src.begin(), src.end())));
+    for (const entities::Expression& expr: src)
+    {
+      writer.put(cells, writer(expr));
+    }
+
+    writer.put(cells, static_cast< std::uint32_t >(src.aliases.size()));
+    for (const entities::Alias& alias: src.aliases)
+    {
+      writer.put_variable(cells, {alias.type, alias.name});
+    }
+    writer.put(cells, static_cast< std::uint32_t >(src.variables.size()));
+    for (const std::pair< entities::Variable, size_t >& var: src.variables)
+    {
+      writer.put_variable(cells, var.first);
+      writer.put(cells, static_cast< std::uint64_t >(var.second));
+    }
+    writer.put(cells, static_cast< std::uint32_t >(src.defined_functions.size()));
+    for (const entities::Variable& func: src.defined_functions)
+    {
+      writer.put_variable(cells, func);
+    }
+    writer.put(cells, static_cast< std::uint32_t >(src.structs.size()));
+    for (const std::pair< entities::Struct, size_t >& structure: src.structs)
+    {
+      writer.put_struct(cells, structure.first.name, structure.first.fields);
+      writer.put(cells, static_cast< std::uint64_t >(structure.second));
+    }
+    writer.put(cells, static_cast< std::uint32_t >(src.unions.size()));
+    for (const std::pair< entities::Union, size_t >& structure: src.unions)
+    {
+      writer.put_struct(cells, structure.first.name, structure.first.fields);
+      writer.put(cells, static_cast< std::uint64_t >(structure.second));
+    }
+    writer.put(cells, static_cast< std::uint32_t >(src.enums.size()));
+    for (const std::pair< entities::Enum, size_t >& structure: src.enums)
+    {
+      writer.put_enum(cells, structure.first);
+      writer.put(cells, static_cast< std::uint64_t >(structure.second));
+    }
+    writer.put(cells, static_cast< std::uint32_t >(src.base_types.size()));
+    for (const std::pair< typing::Type, size_t >& type: src.base_types)
+    {
+      writer.put(cells, writer.type_id(type.first));
+      writer.put(cells, static_cast< std::uint64_t >(type.second));
+    }
+  }
+  out << writer.finish(cells);
+  return out.good();
+}
+bool rychkov::MainProcessor::load_snapshot(std::ostream& out, std::ostream& err, const std::string& filename)
+{
+  std::ifstream in(filename, std::ios::binary | std::ios::ate);
+  if (!in)
+  {
+    err << "failed to open save file on read - \"" << filename << "\"\n";
+    return false;
+  }
+  std::string data(static_cast< size_t >(in.tellg()), '\0');
+  in.seekg(0);
+  if (!in.read(&data[0], data.size()))
+  {
+    err << "failed to read save file - \"" << filename << "\"\n";
+    return false;
+  }
+  SnapshotReader reader{std::move(data)};
+  std::map< std::string, ParseCell > new_parsed;
+  size_t ngenerated = 0;
+  for (std::uint32_t ncells = reader.get_u32(); ncells > 0; ncells--)
+  {
+    const std::string& name = reader.get_string();
+    std::pair< decltype(new_parsed)::iterator, bool > cell_p = new_parsed.emplace(name,
+          ParseCell{{out, err, name}, last_stage_, include_dirs_});
+    if (!cell_p.second)
+    {
+      throw std::invalid_argument{"repeated file in snapshot"};
+    }
+    ParseCell& cell = cell_p.first->second;
+    out << "<--LOAD: \"" << name << "\"-->\n";
+    cell.real_file = reader.get_u8() != 0;
+    ngenerated += !cell.real_file;
+    cell.cache = reader.get_string();
+
+    Preprocessor& preproc = cell.preproc;
+    for (std::uint32_t n = reader.get_u32(); n > 0; n--)
+    {
+      preproc.macros.insert(reader.get_macro());
+    }
+    for (std::uint32_t n = reader.get_u32(); n > 0; n--)
+    {
+      preproc.legacy_macros.insert(reader.get_macro());
+    }
+    CParser& parser = *preproc.next->next;
+    std::vector< entities::Expression > program;
+    for (std::uint32_t n = reader.get_u32(); n > 0; n--)
+    {
+      program.push_back(reader.take_expr(reader.get_u32()));
+    }
+    parser.assign(std::move(program), reader.arena());
+
+    for (std::uint32_t n = reader.get_u32(); n > 0; n--)
+    {
+      entities::Variable alias = reader.get_variable();
+      parser.aliases.insert({std::move(alias.type), std::move(alias.name)});
+    }
+    for (std::uint32_t n = reader.get_u32(); n > 0; n--)
+    {
+      entities::Variable var = reader.get_variable();
+      parser.variables.emplace(std::move(var), reader.get_u64());
+    }
+    for (std::uint32_t n = reader.get_u32(); n > 0; n--)
+    {
+      parser.defined_functions.insert(reader.get_variable());
+    }
+    for (std::uint32_t n = reader.get_u32(); n > 0; n--)
+    {
+      entities::Struct structure{reader.get_string(), reader.get_fields()};
+      parser.structs.emplace(std::move(structure), reader.get_u64());
+    }
+    for (std::uint32_t n = reader.get_u32(); n > 0; n--)
+    {
+      entities::Union structure{reader.get_string(), reader.get_fields()};
+      parser.unions.emplace(std::move(structure), reader.get_u64());
+    }
+    for (std::uint32_t n = reader.get_u32(); n > 0; n--)
+    {
+      entities::Enum structure = reader.get_enum();
+      parser.enums.emplace(std::move(structure), reader.get_u64());
+    }
+    parser.base_types.clear();
+    for (std::uint32_t n = reader.get_u32(); n > 0; n--)
+    {
+      typing::Type type = reader.get_type();
+      parser.base_types.emplace(std::move(type), reader.get_u64());
+    }
+  }
+  if (!reader.done())
+  {
+    throw std::invalid_argument{"unexpected data after snapshot"};
+  }
+  parsed_ = std::move(new_parsed);
+  generated_files = ngenerated;
+  return true;
+}
+
+std::string rychkov::SnapshotWriter::finish(const std::string& cells)
+{
+  std::string result = snapshot_magic;
+  put(result, nstrings_);
+  result += strings_;
+  put(result, ntypes_);
+  result += types_;
+  put(result, nnodes_);
+  result += nodes_;
+  result += cells;
+  return result;
+}
+void rychkov::SnapshotWriter::put(std::string& out, std::uint8_t value)
+{
+  out += static_cast< char >(value);
+}
+void rychkov::SnapshotWriter::put(std::string& out, std::uint32_t value)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    out += static_cast< char >((value >> (8 * i)) & 0xFF);
+  }
+}
+void rychkov::SnapshotWriter::put(std::string& out, std::uint64_t value)
+{
+  for (int i = 0; i < 8; i++)
+  {
+    out += static_cast< char >((value >> (8 * i)) & 0xFF);
+  }
+}
+std::uint32_t rychkov::SnapshotWriter::string_id(const std::string& str)
+{
+  std::pair< decltype(string_ids_)::iterator, bool > id_p = string_ids_.emplace(str, nstrings_);
+  if (id_p.second)
+  {
+    put(strings_, static_cast< std::uint32_t >(str.length()));
+    strings_ += str;
+    nstrings_++;
+  }
+  return id_p.first->second;
+}
+std::uint32_t rychkov::SnapshotWriter::type_id(const typing::Type& type)
+{
+  std::uint32_t base = (type.base != nullptr ? type_id(*type.base) : none);
+  std::vector< std::uint32_t > parameters;
+  parameters.reserve(type.function_parameters.size());
+  for (const typing::Type& parameter: type.function_parameters)
+  {
+    parameters.push_back(type_id(parameter));
+  }
+  std::string record;
+  put(record, string_id(type.name));
+  put(record, static_cast< std::uint8_t >(type.category));
+  put(record, base);
+  put(record, static_cast< std::uint8_t >((type.is_const ? TYPE_CONST : 0) | (type.is_volatile ? TYPE_VOLATILE : 0)
+        | (type.is_signed ? TYPE_SIGNED : 0) | (type.is_unsigned ? TYPE_UNSIGNED : 0)
+        | (type.array_has_length ? TYPE_HAS_LENGTH : 0)));
+  put(record, static_cast< std::uint8_t >(type.length_category));
+  put(record, static_cast< std::uint64_t >(type.array_length));
+  put(record, static_cast< std::uint32_t >(parameters.size()));
+  for (std::uint32_t parameter: parameters)
+  {
+    put(record, parameter);
+  }
+  std::pair< decltype(type_ids_)::iterator, bool > id_p = type_ids_.emplace(record, ntypes_);
+  if (id_p.second)
+  {
+    types_ += record;
+    ntypes_++;
+  }
+  return id_p.first->second;
+}
+void rychkov::SnapshotWriter::put_macro(std::string& out, const Macro& macro)
+{
+  put(out, string_id(macro.name));
+  put(out, string_id(macro.body));
+  put(out, static_cast< std::uint8_t >(macro.func_style));
+  put(out, static_cast< std::uint32_t >(macro.parameters.size()));
+  for (const std::string& parameter: macro.parameters)
+  {
+    put(out, string_id(parameter));
+  }
+}
+void rychkov::SnapshotWriter::put_variable(std::string& out, const entities::Variable& var)
+{
+  put(out, type_id(var.type));
+  put(out, string_id(var.name));
+}
+void rychkov::SnapshotWriter::put_struct(std::string& out, const std::string& name,
+    const std::set< entities::Variable, NameCompare >& fields)
+{
+  put(out, string_id(name));
+  put(out, static_cast< std::uint32_t >(fields.size()));
+  for (const entities::Variable& field: fields)
+  {
+    put_variable(out, field);
+  }
+}
+void rychkov::SnapshotWriter::put_enum(std::string& out, const entities::Enum& structure)
+{
+  put(out, string_id(structure.name));
+  put(out, static_cast< std::uint32_t >(structure.fields.size()));
+  for (const std::pair< const std::string, int >& field: structure.fields)
+  {
+    put(out, string_id(field.first));
+    put(out, static_cast< std::uint32_t >(field.second));
+  }
+}
+std::uint32_t rychkov::SnapshotWriter::add_node(const std::string& record)
+{
+  nodes_ += record;
+  return nnodes_++;
+}
+std::uint32_t rychkov::SnapshotWriter::operator()(const entities::Expression& expr)
+{
+  std::vector< std::uint32_t > operands;
+  operands.reserve(expr.operands.size());
+  for (const entities::Expression::operand& operand: expr.operands)
+  {
+    operands.push_back(boost::variant2::visit(*this, operand));
+  }
+  std::string record;
+  put(record, static_cast< std::uint8_t >(EXPR_NODE));
+  put(record, static_cast< std::uint8_t >(expr.operation != nullptr));
+  if (expr.operation != nullptr)
+  {
+    put(record, string_id(expr.operation->token));
+    put(record, static_cast< std::uint8_t >(expr.operation->right_align));
+    put(record, static_cast< std::uint8_t >(expr.operation->type));
+  }
+  put(record, type_id(expr.result_type));
+  put(record, static_cast< std::uint32_t >(operands.size()));
+  for (std::uint32_t operand: operands)
+  {
+    put(record, operand);
+  }
+  return add_node(record);
+}
+std::uint32_t rychkov::SnapshotWriter::operator()(const NodeRef< entities::Expression >& expr)
+{
+  return expr != nullptr ? operator()(*expr) : none;
+}
+std::uint32_t rychkov::SnapshotWriter::operator()(const entities::Variable& var)
+{
+  std::string record;
+  put(record, static_cast< std::uint8_t >(VAR_NODE));
+  put_variable(record, var);
+  return add_node(record);
+}
+std::uint32_t rychkov::SnapshotWriter::operator()(const entities::Declaration& decl)
+{
+  std::string record;
+  put(record, static_cast< std::uint8_t >(DECL_NODE));
+  put_declared(record, decl.data);
+  put(record, operator()(decl.value));
+  put(record, static_cast< std::uint8_t >(decl.scope));
+  return add_node(record);
+}
+void rychkov::SnapshotWriter::put_declared(std::string& out, const entities::Declaration::declared& data)
+{
+  put(out, static_cast< std::uint8_t >(data.index()));
+  switch (data.index())
+  {
+  case DECLARED_VAR:
+    put_variable(out, boost::variant2::get< entities::Variable >(data));
+    break;
+  case DECLARED_STRUCT:
+  {
+    const entities::Struct& structure = boost::variant2::get< entities::Struct >(data);
+    put_struct(out, structure.name, structure.fields);
+    break;
+  }
+  case DECLARED_ENUM:
+    put_enum(out, boost::variant2::get< entities::Enum >(data));
+    break;
+  case DECLARED_UNION:
+  {
+    const entities::Union& structure = boost::variant2::get< entities::Union >(data);
+    put_struct(out, structure.name, structure.fields);
+    break;
+  }
+  case DECLARED_ALIAS:
+  {
+    const entities::Alias& alias = boost::variant2::get< entities::Alias >(data);
+    put_variable(out, {alias.type, alias.name});
+    break;
+  }
+  case DECLARED_FUNC:
+  {
+    const entities::Function& func = boost::variant2::get< entities::Function >(data);
+    put_variable(out, {func.type, func.name});
+    put(out, static_cast< std::uint32_t >(func.parameters.size()));
+    for (const std::string& parameter: func.parameters)
+    {
+      put(out, string_id(parameter));
+    }
+    break;
+  }
+  default:
+  {
+    const entities::Statement& statement = boost::variant2::get< entities::Statement >(data);
+    std::vector< std::uint32_t > conditions;
+    conditions.reserve(statement.conditions.size());
+    for (const entities::Expression& condition: statement.conditions)
+    {
+      conditions.push_back(operator()(condition));
+    }
+    put(out, static_cast< std::uint8_t >(statement.type));
+    put(out, static_cast< std::uint32_t >(conditions.size()));
+    for (std::uint32_t condition: conditions)
+    {
+      put(out, condition);
+    }
+    break;
+  }
+  }
+}
+std::uint32_t rychkov::SnapshotWriter::operator()(const entities::Literal& lit)
+{
+  std::string record;
+  put(record, static_cast< std::uint8_t >(LIT_NODE));
+  put(record, string_id(lit.literal));
+  put(record, string_id(lit.suffix));
+  put(record, static_cast< std::uint8_t >(lit.type));
+  put(record, type_id(lit.result_type));
+  return add_node(record);
+}
+std::uint32_t rychkov::SnapshotWriter::operator()(const entities::CastOperation& cast)
+{
+  std::uint32_t expr = operator()(cast.expr);
+  std::string record;
+  put(record, static_cast< std::uint8_t >(CAST_NODE));
+  put(record, type_id(cast.to));
+  put(record, static_cast< std::uint8_t >(cast.is_explicit));
+  put(record, expr);
+  return add_node(record);
+}
+std::uint32_t rychkov::SnapshotWriter::operator()(const entities::Body& body)
+{
+  std::vector< std::uint32_t > data;
+  data.reserve(body.data.size());
+  for (const entities::Expression& expr: body.data)
+  {
+    data.push_back(operator()(expr));
+  }
+  std::string record;
+  put(record, static_cast< std::uint8_t >(BODY_NODE));
+  put(record, static_cast< std::uint32_t >(data.size()));
+  for (std::uint32_t expr: data)
+  {
+    put(record, expr);
+  }
+  return add_node(record);
+}
+
+rychkov::SnapshotReader::SnapshotReader(std::string data):
+  data_(std::move(data))
+{
+  if (data_.compare(0, snapshot_magic_size, snapshot_magic) != 0)
+  {
+    throw std::invalid_argument{"not a snapshot file"};
+  }
+  pos_ = snapshot_magic_size;
+  strings_.resize(get_count(4));
+  for (std::string& str: strings_)
+  {
+    size_t length = get_u32();
+    if (length > data_.size() - pos_)
+    {
+      throw std::invalid_argument{"unexpected end of snapshot"};
+    }
+    str.assign(data_, pos_, length);
+    pos_ += length;
+  }
+  size_t count = get_count(19);
+  types_.reserve(count);
+  for (; count > 0; count--)
+  {
+    read_type();
+  }
+  size_t nnodes = get_count(2);
+  nodes_.reserve(nnodes);
+  taken_.resize(nnodes, false);
+  for (; nnodes > 0; nnodes--)
+  {
+    read_node();
+  }
+}
+std::shared_ptr< rychkov::CParser::node_arena > rychkov::SnapshotReader::arena() const noexcept
+{
+  return arena_;
+}
+bool rychkov::SnapshotReader::done() const noexcept
+{
+  return pos_ == data_.size();
+}
+std::uint8_t rychkov::SnapshotReader::get_u8()
+{
+  if (pos_ >= data_.size())
+  {
+    throw std::invalid_argument{"unexpected end of snapshot"};
+  }
+  return static_cast< std::uint8_t >(data_[pos_++]);
+}
+std::uint32_t rychkov::SnapshotReader::get_u32()
+{
+  std::uint32_t result = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    result |= static_cast< std::uint32_t >(get_u8()) << (8 * i);
+  }
+  return result;
+}
+std::uint64_t rychkov::SnapshotReader::get_u64()
+{
+  std::uint64_t result = 0;
+  for (int i = 0; i < 8; i++)
+  {
+    result |= static_cast< std::uint64_t >(get_u8()) << (8 * i);
+  }
+  return result;
+}
+size_t rychkov::SnapshotReader::get_count(size_t min_record_size)
+{
+  size_t count = get_u32();
+  if (count > (data_.size() - pos_) / min_record_size)
+  {
+    throw std::invalid_argument{"unexpected end of snapshot"};
+  }
+  return count;
+}
+const std::string& rychkov::SnapshotReader::get_string()
+{
+  std::uint32_t id = get_u32();
+  if (id >= strings_.size())
+  {
+    throw std::invalid_argument{"wrong string index"};
+  }
+  return strings_[id];
+}
+const rychkov::typing::Type& rychkov::SnapshotReader::get_type()
+{
+  std::uint32_t id = get_u32();
+  if (id >= types_.size())
+  {
+    throw std::invalid_argument{"wrong type index"};
+  }
+  return types_[id];
+}
+void rychkov::SnapshotReader::read_type()
+{
+  typing::Type type;
+  type.name = get_string();
+  std::uint8_t category = get_u8();
+  if (category > typing::COMBINATION)
+  {
+    throw std::invalid_argument{"wrong type category"};
+  }
+  type.category = static_cast< typing::Category >(category);
+  std::uint32_t base = get_u32();
+  if (base != SnapshotWriter::none)
+  {
+    if (base >= types_.size())
+    {
+      throw std::invalid_argument{"wrong type index"};
+    }
+    type.base = types_[base];
+  }
+  std::uint8_t flags = get_u8();
+  type.is_const = flags & TYPE_CONST;
+  type.is_volatile = flags & TYPE_VOLATILE;
+  type.is_signed = flags & TYPE_SIGNED;
+  type.is_unsigned = flags & TYPE_UNSIGNED;
+  type.array_has_length = flags & TYPE_HAS_LENGTH;
+  std::uint8_t length = get_u8();
+  if (length > typing::LONG_LONG)
+  {
+    throw std::invalid_argument{"wrong type length"};
+  }
+  type.length_category = static_cast< typing::LengthCategory >(length);
+  type.array_length = get_u64();
+  size_t count = get_count(4);
+  type.function_parameters.reserve(count);
+  for (; count > 0; count--)
+  {
+    type.function_parameters.push_back(get_type());
+  }
+  types_.push_back(std::move(type));
+}
+rychkov::Macro rychkov::SnapshotReader::get_macro()
+{
+  Macro result{get_string(), get_string()};
+  result.func_style = get_u8() != 0;
+  size_t count = get_count(4);
+  result.parameters.reserve(count);
+  for (; count > 0; count--)
+  {
+    result.parameters.push_back(get_string());
+  }
+  return result;
+}
+rychkov::entities::Variable rychkov::SnapshotReader::get_variable()
+{
+  typing::Type type = get_type();
+  return {std::move(type), get_string()};
+}
+std::set< rychkov::entities::Variable, rychkov::NameCompare > rychkov::SnapshotReader::get_fields()
+{
+  std::set< entities::Variable, NameCompare > result;
+  for (size_t n = get_count(8); n > 0; n--)
+  {
+    result.insert(get_variable());
+  }
+  return result;
+}
+rychkov::entities::Enum rychkov::SnapshotReader::get_enum()
+{
+  entities::Enum result{get_string()};
+  for (size_t n = get_count(8); n > 0; n--)
+  {
+    const std::string& name = get_string();
+    result.fields.emplace(name, static_cast< int >(get_u32()));
+  }
+  return result;
+}
+rychkov::entities::Expression::operand rychkov::SnapshotReader::take_operand(std::uint32_t id)
+{
+  if (id == SnapshotWriter::none)
+  {
+    return NodeRef< entities::Expression >{nullptr};
+  }
+  if ((id >= nodes_.size()) || taken_[id])
+  {
+    throw std::invalid_argument{"wrong node index"};
+  }
+  taken_[id] = true;
+  return std::move(nodes_[id]);
+}
+rychkov::NodeRef< rychkov::entities::Expression > rychkov::SnapshotReader::take_node(std::uint32_t id)
+{
+  entities::Expression::operand operand = take_operand(id);
+  using expr_ptr = NodeRef< entities::Expression >;
+  expr_ptr* expr = boost::variant2::get_if< expr_ptr >(&operand);
+  if ((expr == nullptr) || (*expr == nullptr))
+  {
+    throw std::invalid_argument{"expression expected"};
+  }
+  return std::move(*expr);
+}
+rychkov::entities::Expression rychkov::SnapshotReader::take_expr(std::uint32_t id)
+{
+  return std::move(*take_node(id));
+}
+void rychkov::SnapshotReader::read_node()
+{
+  switch (get_u8())
+  {
+  case EXPR_NODE:
+  {
+    entities::Expression result;
+    if (get_u8() != 0)
+    {
+      const std::string& token = get_string();
+      bool right_align = get_u8() != 0;
+      result.operation = find_operator(token, right_align, static_cast< std::int8_t >(get_u8()));
+      if (result.operation == nullptr)
+      {
+        throw std::invalid_argument{"unknown operator"};
+      }
+    }
+    result.result_type = get_type();
+    size_t count = get_count(4);
+    result.operands.reserve(count);
+    for (; count > 0; count--)
+    {
+      result.operands.push_back(take_operand(get_u32()));
+    }
+    nodes_.push_back(NodeRef< entities::Expression >{arena_->make(std::move(result))});
+    break;
+  }
+  case VAR_NODE:
+    nodes_.push_back(get_variable());
+    break;
+  case DECL_NODE:
+  {
+    entities::Declaration result{get_declared()};
+    std::uint32_t value = get_u32();
+    if (value != SnapshotWriter::none)
+    {
+      result.value = take_node(value);
+    }
+    std::uint8_t scope = get_u8();
+    if (scope > entities::UNSPECIFIED)
+    {
+      throw std::invalid_argument{"wrong scope type"};
+    }
+    result.scope = static_cast< entities::ScopeType >(scope);
+    nodes_.push_back(std::move(result));
+    break;
+  }
+  case LIT_NODE:
+  {
+    entities::Literal result{get_string(), get_string()};
+    std::uint8_t type = get_u8();
+    if (type > entities::Literal::Number)
+    {
+      throw std::invalid_argument{"wrong literal type"};
+    }
+    result.type = static_cast< entities::Literal::Type >(type);
+    result.result_type = get_type();
+    nodes_.push_back(std::move(result));
+    break;
+  }
+  case CAST_NODE:
+  {
+    entities::CastOperation result{get_type()};
+    result.is_explicit = get_u8() != 0;
+    std::uint32_t expr = get_u32();
+    if (expr != SnapshotWriter::none)
+    {
+      result.expr = take_node(expr);
+    }
+    else
+    {
+      result.expr = nullptr;
+    }
+    nodes_.push_back(std::move(result));
+    break;
+  }
+  case BODY_NODE:
+  {
+    entities::Body result;
+    result.data.clear();
+    size_t count = get_count(4);
+    result.data.reserve(count);
+    for (; count > 0; count--)
+    {
+      result.data.push_back(take_expr(get_u32()));
+    }
+    nodes_.push_back(std::move(result));
+    break;
+  }
+  default:
+    throw std::invalid_argument{"unknown node kind"};
+  }
+}
+rychkov::entities::Declaration::declared rychkov::SnapshotReader::get_declared()
+{
+  switch (get_u8())
+  {
+  case DECLARED_VAR:
+    return get_variable();
+  case DECLARED_STRUCT:
+  {
+    const std::string& name = get_string();
+    return entities::Struct{name, get_fields()};
+  }
+  case DECLARED_ENUM:
+    return get_enum();
+  case DECLARED_UNION:
+  {
+    const std::string& name = get_string();
+    return entities::Union{name, get_fields()};
+  }
+  case DECLARED_ALIAS:
+  {
+    entities::Variable alias = get_variable();
+    return entities::Alias{std::move(alias.type), std::move(alias.name)};
+  }
+  case DECLARED_FUNC:
+  {
+    entities::Variable sign = get_variable();
+    entities::Function result{std::move(sign.type), std::move(sign.name)};
+    size_t count = get_count(4);
+    result.parameters.reserve(count);
+    for (; count > 0; count--)
+    {
+      result.parameters.push_back(get_string());
+    }
+    return result;
+  }
+  case DECLARED_STATEMENT:
+  {
+    std::uint8_t type = get_u8();
+    if (type >= entities::Statement::TYPE_LAST)
+    {
+      throw std::invalid_argument{"wrong statement type"};
+    }
+    entities::Statement result{static_cast< entities::Statement::Type >(type)};
+    size_t count = get_count(4);
+    result.conditions.reserve(count);
+    for (; count > 0; count--)
+    {
+      result.conditions.push_back(take_expr(get_u32()));
+    }
+    return result;
+  }
+  default:
+    throw std::invalid_argument{"unknown declared"};
+  }
+}
@@ -0,0 +1,111 @@
+#ifndef NODE_ARENA_HPP
+#define NODE_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rychkov
+{
+  template< class T >
+  class NodeRef
+  {
+  public:
+    using value_type = T;
+
+    NodeRef(T* node = nullptr) noexcept:
+      node_{node}
+    {}
+
+    T* get() const noexcept
+    {
+      return node_;
+    }
+    T& operator*() const noexcept
+    {
+      return *node_;
+    }
+    T* operator->() const noexcept
+    {
+      return node_;
+    }
+    bool operator==(std::nullptr_t) const noexcept
+    {
+      return node_ == nullptr;
+    }
+    bool operator!=(std::nullptr_t) const noexcept
+    {
+      return node_ != nullptr;
+    }
+
+  private:
+    T* node_;
+  };
+
+  template< class T >
+  class NodeArena
+  {
+  public:
+    NodeArena() = default;
+    NodeArena(const NodeArena&) = delete;
+    ~NodeArena();
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    template< class... Args >
+    T* make(Args&&... args);
+
+  private:
+    static constexpr size_t first_chunk_size = 32;
+    static constexpr size_t max_chunk_size = 1024;
+    using storage = typename std::aligned_storage< sizeof(T), alignof(T) >::type;
+
+    std::vector< std::unique_ptr< storage[] > > chunks_;
+    size_t used_ = 0;
+
+    static size_t chunk_capacity(size_t index) noexcept;
+  };
+}
+
+template< class T >
+rychkov::NodeArena< T >::~NodeArena()
+{
+  while (!chunks_.empty())
+  {
+    T* chunk = reinterpret_cast< T* >(chunks_.back().get());
+    for (; used_ > 0; used_--)
+    {
+      chunk[used_ - 1].~T();
+    }
+    chunks_.pop_back();
+    used_ = chunks_.empty() ? 0 : chunk_capacity(chunks_.size() - 1);
+  }
+}
+template< class T >
+template< class... Args >
+T* rychkov::NodeArena< T >::make(Args&&... args)
+{
+  if (chunks_.empty() || (used_ == chunk_capacity(chunks_.size() - 1)))
+  {
+    std::unique_ptr< storage[] > chunk{new storage[chunk_capacity(chunks_.size())]};
+    chunks_.push_back(std::move(chunk));
+    used_ = 0;
+  }
+  T* result = new (&chunks_.back()[used_]) T{std::forward< Args >(args)...};
+  used_++;
+  return result;
+}
+template< class T >
+size_t rychkov::NodeArena< T >::chunk_capacity(size_t index) noexcept
+{
+  size_t capacity = first_chunk_size;
+  for (; (index > 0) && (capacity < max_chunk_size); index--)
+  {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+#endif
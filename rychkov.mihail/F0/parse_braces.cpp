@@ -29,7 +29,8 @@ void rychkov::CParser::parse_open_brace(CParseContext& context)
       {
         if (!data.parameters[i].empty())
         {
-          variables.insert({{data.type.function_parameters[i], data.parameters[i]}, stack_.size() + 1});
+          declare(variables, &ScopeLog::variables,
+                {{data.type.function_parameters[i], data.parameters[i]}, stack_.size() + 1});
         }
       }
       if (find_overload(data.name, data.type.function_parameters).first != nullptr)
@@ -47,7 +48,7 @@ void rychkov::CParser::parse_open_brace(CParseContext& context)
       log(context, "braced enclosed body cannot follow this declaration");
       return;
     }
-    decl.value = entities::Body{};
+    decl.value = make_node(entities::Body{});
     stack_.push(&*decl.value);
     entities::Body& body = boost::variant2::get< entities::Body >(stack_.top()->operands[0]);
     stack_.push(&body.data[0]);
@@ -40,14 +40,14 @@ void rychkov::CParser::fold(CParseContext& context, const Operator* reference)
 }
 rychkov::entities::Expression* rychkov::CParser::move_up()
 {
-  entities::Expression* temp = new entities::Expression{std::move(*stack_.top())};
+  entities::Expression* temp = make_node(std::move(*stack_.top()));
   stack_.top()->operation = nullptr;
   stack_.top()->operands.push_back(temp);
   return temp;
 }
 void rychkov::CParser::move_down()
 {
-  entities::Expression* temp = new entities::Expression{nullptr, {std::move(stack_.top()->operands.back())}};
+  entities::Expression* temp = make_node({nullptr, {std::move(stack_.top()->operands.back())}});
   stack_.top()->operands.back() = temp;
   stack_.push(temp);
 }
@@ -58,9 +58,14 @@ void rychkov::CParser::move_up_down()
 
 void rychkov::CParser::clear_scope()
 {
-  clear_scope(base_types, stack_.size());
-  clear_scope(variables, stack_.size());
-  clear_scope(structs, stack_.size());
-  clear_scope(unions, stack_.size());
-  clear_scope(enums, stack_.size());
+  for (size_t scope = scope_logs_.size(); scope > stack_.size() + 1; scope--)
+  {
+    const ScopeLog& log = scope_logs_.back();
+    undo_scope(base_types, log.base_types, scope - 1);
+    undo_scope(variables, log.variables, scope - 1);
+    undo_scope(structs, log.structs, scope - 1);
+    undo_scope(unions, log.unions, scope - 1);
+    undo_scope(enums, log.enums, scope - 1);
+    scope_logs_.pop_back();
+  }
 }
@@ -44,7 +44,7 @@ void rychkov::CParser::parse_return(CParseContext& context)
 {
   if (stack_.top()->empty())
   {
-    entities::Expression* temp = new entities::Expression;
+    entities::Expression* temp = make_node();
     stack_.top()->operands.push_back(entities::Declaration{entities::Statement{entities::Statement::RETURN}, temp});
     stack_.push(temp);
     return;
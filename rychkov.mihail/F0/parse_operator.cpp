@@ -28,7 +28,7 @@ void rychkov::CParser::append(CParseContext& context, const std::vector< rychkov
       entities::Declaration& decl = boost::variant2::get< entities::Declaration >(stack_.top()->operands[0]);
       if (boost::variant2::holds_alternative< entities::Variable >(decl.data))
       {
-        decl.value = entities::Expression{};
+        decl.value = make_node();
         stack_.push(&*decl.value);
         return;
       }
@@ -83,7 +83,7 @@ bool rychkov::CParser::parse_unary(CParseContext& context, const rychkov::Operat
     {
       return false;
     }
-    entities::Expression* temp = new entities::Expression{&oper, {}};
+    entities::Expression* temp = make_node({&oper, {}});
     stack_.top()->operands.push_back(temp);
     stack_.push(temp);
   }
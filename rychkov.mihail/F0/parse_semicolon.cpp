@@ -43,8 +43,9 @@ void rychkov::CParser::parse_semicolon(CParseContext& context)
         return;
       }
       stack_.pop();
-      structs.insert(std::make_pair(data, stack_.size()));
-      base_types.insert(std::make_pair(typing::Type{data.name, typing::STRUCT}, stack_.size()));
+      declare(structs, &ScopeLog::structs, std::make_pair(data, stack_.size()));
+      declare(base_types, &ScopeLog::base_types,
+            std::make_pair(typing::Type{data.name, typing::STRUCT}, stack_.size()));
       append_empty(context);
       return;
     }
@@ -23,7 +23,7 @@ void rychkov::CParser::parse_open_parenthesis(CParseContext& context)
     move_down();
     stack_.top()->operation = &parentheses;
   }
-  entities::Expression* temp = new entities::Expression;
+  entities::Expression* temp = make_node();
   stack_.top()->operands.push_back(temp);
   stack_.push(temp);
 }
@@ -45,7 +45,7 @@ void rychkov::CParser::parse_close_parenthesis(CParseContext& context)
           remove_bridge(*last);
           calculate_type(context, *last);
           require_type(context, statement.conditions[0], {"int", typing::BASIC});
-          entities::Expression* temp = new entities::Expression;
+          entities::Expression* temp = make_node();
           decl.value = temp;
           stack_.push(temp);
           return;
@@ -79,7 +79,7 @@ void rychkov::CParser::parse_open_bracket(CParseContext& context)
   }
   move_down();
   stack_.top()->operation = &brackets;
-  entities::Expression* temp = new entities::Expression;
+  entities::Expression* temp = make_node();
   stack_.top()->operands.push_back(temp);
   stack_.push(temp);
 }
@@ -107,7 +107,7 @@ void rychkov::CParser::parse_comma(CParseContext& context)
   if (stack_.top()->operation == &parentheses)
   {
     remove_bridge(*last);
-    entities::Expression* temp = new entities::Expression{};
+    entities::Expression* temp = make_node();
     stack_.top()->operands.push_back(temp);
     stack_.push(temp);
     return;
@@ -236,7 +236,7 @@ void rychkov::CParser::require_type(CParseContext& context, entities::Expression
     break;
   case typing::IMPLICIT:
   {
-    entities::CastOperation temp = {type, false, entities::Expression{nullptr, {std::move(expr)}}};
+    entities::CastOperation temp = {type, false, make_node({nullptr, {std::move(expr)}})};
     expr = std::move(temp);
     break;
   }
@@ -260,7 +260,7 @@ void rychkov::CParser::require_type(CParseContext& context, entities::Expression
     break;
   case typing::IMPLICIT:
   {
-    entities::CastOperation temp = {type, false, std::move(expr)};
+    entities::CastOperation temp = {type, false, make_node(std::move(expr))};
     expr = std::move(temp);
     calculate_type(context, *boost::variant2::get< entities::CastOperation >(expr.operands[0]).expr);
     break;
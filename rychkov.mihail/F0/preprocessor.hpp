@@ -14,6 +14,7 @@
 #include "content.hpp"
 #include "compare.hpp"
 #include "lexer.hpp"
+#include "include_cache.hpp"
 
 namespace rychkov
 {
@@ -24,6 +25,9 @@ namespace rychkov
     std::unique_ptr< Lexer > next;
     std::set< Macro, NameCompare > macros;
     std::multiset< Macro, NameCompare > legacy_macros;
+    std::shared_ptr< IncludeCache > include_cache;
+    std::map< std::string, size_t > included_files;
+    std::set< std::string > missing_files;
 
     Preprocessor();
     Preprocessor(std::unique_ptr< Lexer > lexer, std::vector< std::string > search_dirs);
@@ -83,6 +87,7 @@ namespace rychkov
     bool skip_all() const noexcept;
     void flush_buf(CParseContext& context);
     void expanse_macro(CParseContext& context);
+    std::shared_ptr< const IncludedFile > load_file(const std::string& path);
 
     void include(std::istream& in, CParseContext& context);
     void define(std::istream& in, CParseContext& context);
@@ -1,7 +1,7 @@
 #include "preprocessor.hpp"
 
 #include <iostream>
-#include <fstream>
+#include <sstream>
 #include <utility>
 #include <cctype>
 #include <parser.hpp>
@@ -33,32 +33,59 @@ void rychkov::Preprocessor::include(std::istream& in, CParseContext& context)
   }
 
   buf_.clear();
-  std::ifstream file;
+  std::shared_ptr< const IncludedFile > file;
   if (quote == '"')
   {
-    file.open(filename);
+    file = load_file(filename);
+  }
+  else if (include_paths.empty())
+  {
+    return;
   }
   else
   {
     for (const std::string& base_path: include_paths)
     {
-      file.open(base_path + '/' + filename);
-      if (file.is_open())
+      file = load_file(base_path + '/' + filename);
+      if (file != nullptr)
       {
         filename = base_path + '/' + filename;
         break;
       }
     }
   }
-  if (!file)
+  if (file == nullptr)
   {
     log(context, "failed to open file");
     return;
   }
   CParseContext file_context = {context.out, context.err, filename, &context};
-  parse(file_context, file, false);
+  if (!file->guard.empty() && (macros.find(file->guard) != macros.end()))
+  {
+    for (char c: file->reentry)
+    {
+      append(file_context, c);
+    }
+    return;
+  }
+  std::istringstream in_file(file->text);
+  parse(file_context, in_file, false);
   context.nerrors += file_context.nerrors;
 }
+std::shared_ptr< const rychkov::IncludedFile > rychkov::Preprocessor::load_file(const std::string& path)
+{
+  std::shared_ptr< const IncludedFile > file = (include_cache != nullptr ? include_cache->get(path)
+      : IncludeCache::read(path));
+  if (file == nullptr)
+  {
+    missing_files.insert(path);
+  }
+  else
+  {
+    included_files[path] = file->hash;
+  }
+  return file;
+}
 void rychkov::Preprocessor::define(std::istream& in, CParseContext& context)
 {
   Macro macro = {get_name(in >> std::ws)};
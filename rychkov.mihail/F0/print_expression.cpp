@@ -2,7 +2,7 @@
 
 #include <iostream>
 
-void rychkov::ContentPrinter::operator()(const DynMemWrapper< entities::Expression >& expr)
+void rychkov::ContentPrinter::operator()(const NodeRef< entities::Expression >& expr)
 {
   operator()(*expr);
 }
@@ -0,0 +1,328 @@
+#include "symbol_index.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace rychkov
+{
+  struct SymbolIndexer
+  {
+    static constexpr size_t none = -1;
+
+    SymbolIndex& index;
+    std::set< std::pair< std::string, size_t >, NameCompare > actives;
+    std::set< std::pair< std::string, size_t >, NameCompare > struct_actives;
+    std::set< std::string > seen;
+    std::string owner;
+    size_t entry = none;
+    size_t depth = 0;
+
+    void operator()(const typing::Type& type);
+    void operator()(const entities::Variable& var);
+    void operator()(const entities::Declaration& decl);
+    void operator()(const entities::Literal& literal);
+    void operator()(const entities::CastOperation& cast);
+    void operator()(const NodeRef< entities::Expression >& root);
+    void operator()(const entities::Expression::operand& operand);
+    void operator()(const entities::Expression& root);
+    void operator()(const entities::Body& body);
+    template< class Entity >
+    void operator()(const std::vector< Entity >& sequence);
+
+    void start_entry(SymbolIndex::Kind kind, const entities::Declaration* decl, const std::string& name);
+    void add_use(const std::string& name);
+    void clear_scope();
+  };
+}
+
+rychkov::SymbolIndex::SymbolIndex(const CParser& parser)
+{
+  SymbolIndexer indexer{*this};
+  for (const entities::Expression& expr: parser)
+  {
+    indexer(expr);
+  }
+}
+const std::vector< rychkov::SymbolIndex::Entry >& rychkov::SymbolIndex::entries() const noexcept
+{
+  return entries_;
+}
+std::vector< size_t > rychkov::SymbolIndex::definitions(const std::string& name, bool struct_like) const
+{
+  std::vector< size_t > result;
+  decltype(definitions_)::const_iterator found = definitions_.find(name);
+  if (found != definitions_.end())
+  {
+    for (size_t i: found->second)
+    {
+      if (struct_like || (entries_[i].kind != STRUCT_LIKE))
+      {
+        result.push_back(i);
+      }
+    }
+  }
+  return result;
+}
+std::vector< size_t > rychkov::SymbolIndex::uses(const std::string& name) const
+{
+  std::vector< size_t > defined = definitions(name, true);
+  decltype(users_)::const_iterator found = users_.find(name);
+  if (found == users_.end())
+  {
+    return defined;
+  }
+  std::vector< size_t > result;
+  result.reserve(defined.size() + found->second.size());
+  std::set_union(defined.begin(), defined.end(), found->second.begin(), found->second.end(),
+        std::back_inserter(result));
+  return result;
+}
+bool rychkov::SymbolIndex::uses(size_t entry, const std::string& name) const
+{
+  decltype(users_)::const_iterator found = users_.find(name);
+  return (found != users_.end()) && std::binary_search(found->second.begin(), found->second.end(), entry);
+}
+rychkov::SymbolIndex::variable_set rychkov::SymbolIndex::dependencies(const std::string& name) const
+{
+  variable_set result;
+  std::vector< size_t > defined = definitions(name, false);
+  if (defined.empty())
+  {
+    return result;
+  }
+  dependency_map levels;
+  std::vector< const variable_set* > stack{&dependencies(name, defined.front(), levels)};
+  std::vector< variable_set::const_iterator > positions{stack.back()->begin()};
+  while (!stack.empty())
+  {
+    if (positions.back() == stack.back()->end())
+    {
+      stack.pop_back();
+      positions.pop_back();
+    }
+    else if (result.insert(*positions.back()).second)
+    {
+      stack.push_back(&dependencies((positions.back()++)->name, defined.front(), levels));
+      positions.push_back(stack.back()->begin());
+    }
+    else
+    {
+      ++positions.back();
+    }
+  }
+  return result;
+}
+const rychkov::SymbolIndex::variable_set& rychkov::SymbolIndex::dependencies(const std::string& name, size_t first,
+    dependency_map& levels) const
+{
+  std::pair< dependency_map::iterator, bool > level = levels.emplace(name, variable_set{});
+  decltype(owned_)::const_iterator owned = owned_.find(name);
+  if (!level.second || (owned == owned_.end()))
+  {
+    return level.first->second;
+  }
+  const std::string& symbol = entries_[first].name;
+  for (size_t i: owned->second)
+  {
+    for (const entities::Variable* ref: entries_[i].refs)
+    {
+      if ((i < first) || (ref->name != symbol))
+      {
+        level.first->second.insert(*ref);
+      }
+    }
+  }
+  return level.first->second;
+}
+
+void rychkov::SymbolIndexer::start_entry(SymbolIndex::Kind kind, const entities::Declaration* decl,
+    const std::string& name)
+{
+  entry = index.entries_.size();
+  if ((kind == SymbolIndex::VARIABLE) || (kind == SymbolIndex::FUNCTION))
+  {
+    owner = name;
+  }
+  index.entries_.push_back({kind, decl, name, owner});
+  index.owned_[owner].push_back(entry);
+  if (kind != SymbolIndex::OTHER)
+  {
+    index.definitions_[name].push_back(entry);
+  }
+  seen.clear();
+}
+void rychkov::SymbolIndexer::add_use(const std::string& name)
+{
+  if ((entry == none) || (index.entries_[entry].kind == SymbolIndex::OTHER))
+  {
+    return;
+  }
+  std::vector< size_t >& users = index.users_[name];
+  if (users.empty() || (users.back() != entry))
+  {
+    users.push_back(entry);
+  }
+}
+void rychkov::SymbolIndexer::clear_scope()
+{
+  CParser::clear_scope(actives, depth);
+  CParser::clear_scope(struct_actives, depth);
+}
+
+void rychkov::SymbolIndexer::operator()(const entities::Variable& var)
+{
+  if (actives.find(var.name) != actives.end())
+  {
+    return;
+  }
+  if (entry == none)
+  {
+    start_entry(SymbolIndex::OTHER, nullptr, {});
+  }
+  if (seen.insert(var.name).second)
+  {
+    index.entries_[entry].refs.push_back(&var);
+  }
+  if (struct_actives.find(var.name) == struct_actives.end())
+  {
+    add_use(var.name);
+  }
+}
+void rychkov::SymbolIndexer::operator()(const typing::Type& type)
+{
+  if (typing::is_function(&type))
+  {
+    operator()(*type.base);
+    std::for_each(type.function_parameters.begin(), type.function_parameters.end(), *this);
+  }
+  else if (type.base == nullptr)
+  {
+    add_use(type.name);
+  }
+  else
+  {
+    operator()(*type.base);
+  }
+}
+void rychkov::SymbolIndexer::operator()(const entities::Declaration& decl)
+{
+  if (depth == 0)
+  {
+    if (boost::variant2::holds_alternative< entities::Variable >(decl.data))
+    {
+      start_entry(SymbolIndex::VARIABLE, &decl, boost::variant2::get< entities::Variable >(decl.data).name);
+    }
+    else if (boost::variant2::holds_alternative< entities::Function >(decl.data))
+    {
+      start_entry(SymbolIndex::FUNCTION, &decl, boost::variant2::get< entities::Function >(decl.data).name);
+    }
+    else if (boost::variant2::holds_alternative< entities::Struct >(decl.data))
+    {
+      start_entry(SymbolIndex::STRUCT_LIKE, &decl, boost::variant2::get< entities::Struct >(decl.data).name);
+    }
+    else if (boost::variant2::holds_alternative< entities::Enum >(decl.data))
+    {
+      start_entry(SymbolIndex::STRUCT_LIKE, &decl, boost::variant2::get< entities::Enum >(decl.data).name);
+    }
+    else if (boost::variant2::holds_alternative< entities::Union >(decl.data))
+    {
+      start_entry(SymbolIndex::STRUCT_LIKE, &decl, boost::variant2::get< entities::Union >(decl.data).name);
+    }
+    else
+    {
+      start_entry(SymbolIndex::OTHER, &decl, {});
+    }
+  }
+  ++depth;
+  if (boost::variant2::holds_alternative< entities::Statement >(decl.data))
+  {
+    operator()(boost::variant2::get< entities::Statement >(decl.data).conditions);
+  }
+  else if (boost::variant2::holds_alternative< entities::Variable >(decl.data))
+  {
+    const entities::Variable& var = boost::variant2::get< entities::Variable >(decl.data);
+    if (depth > 1)
+    {
+      actives.emplace(var.name, depth - 1);
+    }
+    operator()(var.type);
+  }
+  else if (boost::variant2::holds_alternative< entities::Function >(decl.data))
+  {
+    const entities::Function& func = boost::variant2::get< entities::Function >(decl.data);
+    for (const std::string& param: func.parameters)
+    {
+      if (!param.empty())
+      {
+        actives.emplace(param, depth);
+      }
+    }
+    if (depth > 1)
+    {
+      actives.emplace(func.name, depth - 1);
+    }
+    operator()(func.type);
+  }
+  else if (depth > 1)
+  {
+    const std::string* name = nullptr;
+    if (boost::variant2::holds_alternative< entities::Struct >(decl.data))
+    {
+      name = &boost::variant2::get< entities::Struct >(decl.data).name;
+    }
+    else if (boost::variant2::holds_alternative< entities::Enum >(decl.data))
+    {
+      name = &boost::variant2::get< entities::Enum >(decl.data).name;
+    }
+    else if (boost::variant2::holds_alternative< entities::Union >(decl.data))
+    {
+      name = &boost::variant2::get< entities::Union >(decl.data).name;
+    }
+    if (name != nullptr)
+    {
+      struct_actives.emplace(*name, depth - 1);
+    }
+  }
+  operator()(decl.value);
+  --depth;
+  clear_scope();
+  if (depth == 0)
+  {
+    entry = none;
+  }
+}
+void rychkov::SymbolIndexer::operator()(const entities::Literal&)
+{}
+void rychkov::SymbolIndexer::operator()(const entities::CastOperation& cast)
+{
+  operator()(cast.expr);
+}
+void rychkov::SymbolIndexer::operator()(const NodeRef< entities::Expression >& root)
+{
+  if (root != nullptr)
+  {
+    operator()(*root);
+  }
+}
+void rychkov::SymbolIndexer::operator()(const entities::Expression::operand& operand)
+{
+  boost::variant2::visit(*this, operand);
+}
+void rychkov::SymbolIndexer::operator()(const entities::Expression& root)
+{
+  std::for_each(root.operands.begin(), root.operands.end(), std::ref(*this));
+}
+void rychkov::SymbolIndexer::operator()(const entities::Body& body)
+{
+  operator()(body.data);
+}
+template< class Entity >
+void rychkov::SymbolIndexer::operator()(const std::vector< Entity >& sequence)
+{
+  ++depth;
+  std::for_each(sequence.begin(), sequence.end(), std::ref(*this));
+  --depth;
+  clear_scope();
+}
@@ -0,0 +1,57 @@
+#ifndef SYMBOL_INDEX_HPP
+#define SYMBOL_INDEX_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include "content.hpp"
+#include "compare.hpp"
+#include "cparser.hpp"
+
+namespace rychkov
+{
+  class SymbolIndex
+  {
+  public:
+    using variable_set = std::set< entities::Variable, NameCompare >;
+    enum Kind
+    {
+      VARIABLE,
+      FUNCTION,
+      STRUCT_LIKE,
+      OTHER
+    };
+    struct Entry
+    {
+      Kind kind = OTHER;
+      const entities::Declaration* decl = nullptr;
+      std::string name;
+      std::string owner;
+      std::vector< const entities::Variable* > refs;
+    };
+
+    explicit SymbolIndex(const CParser& parser);
+
+    const std::vector< Entry >& entries() const noexcept;
+    std::vector< size_t > definitions(const std::string& name, bool struct_like) const;
+    std::vector< size_t > uses(const std::string& name) const;
+    bool uses(size_t entry, const std::string& name) const;
+    variable_set dependencies(const std::string& name) const;
+
+  private:
+    friend struct SymbolIndexer;
+
+    std::vector< Entry > entries_;
+    std::map< std::string, std::vector< size_t > > definitions_;
+    std::map< std::string, std::vector< size_t > > users_;
+    std::map< std::string, std::vector< size_t > > owned_;
+
+    using dependency_map = std::map< std::string, variable_set >;
+
+    const variable_set& dependencies(const std::string& name, size_t first, dependency_map& levels) const;
+  };
+}
+
+#endif
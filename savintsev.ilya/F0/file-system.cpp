@@ -2,6 +2,7 @@
 #include <fstream>
 #include <algorithm>
 #include <unordered_map>
+#include <utility>
 #include "shape-utils.hpp"
 
 std::string savintsev::get_filename(const std::string & filename)
@@ -104,13 +105,13 @@ void savintsev::read_savi_file(const std::string & filename, Projects & projs)
     {
       throw std::runtime_error("Can't open " + get_filename_wext(filename));
     }
-    new_pair = {figure, new_shape};
+    new_pair = {figure, std::shared_ptr< Shape >(new_shape)};
     project.push_back(new_pair);
 
     file >> figure;
   }
 
-  projs[get_filename(filename)] = project;
+  projs[get_filename(filename)] = std::move(project);
 }
 
 void savintsev::write_savi_file(const std::string & filename, Project & proj)
@@ -122,6 +123,7 @@ void savintsev::write_savi_file(const std::string & filename, Project & proj)
     throw std::runtime_error("Failed to save project to " + filename + ".savi");
   }
 
+  proj.settle();
   for (auto it = proj.begin(); it != proj.end(); ++it)
   {
     file << it->first << " " << it->second->get_name();
@@ -134,17 +136,6 @@ void savintsev::write_savi_file(const std::string & filename, Project & proj)
   }
 }
 
-namespace
-{
-  struct Deleter
-  {
-    void operator()(savintsev::Layer & layer) const
-    {
-      delete layer.second;
-    }
-  };
-}
-
 void savintsev::cleanup_projects_with_backup(Projects & projects)
 {
   struct ProjectProcessor
@@ -153,7 +144,6 @@ void savintsev::cleanup_projects_with_backup(Projects & projects)
     {
       Project & proj = proj_pair.second;
       write_savi_file(proj_pair.first + "_backup", proj);
-      std::for_each(proj.begin(), proj.end(), Deleter());
       proj.clear();
     }
   };
@@ -168,7 +158,6 @@ void savintsev::cleanup_projects_without_backup(Projects& projects)
     void operator()(std::pair< const std::string, Project > & proj_pair) const
     {
       Project & proj = proj_pair.second;
-      std::for_each(proj.begin(), proj.end(), Deleter());
       proj.clear();
     }
   };
@@ -0,0 +1,559 @@
+#include "project-body.hpp"
+#include <algorithm>
+
+savintsev::Project::Body::Body():
+  next_chunk_size(first_chunk_size),
+  free_list(nullptr),
+  root(nullptr),
+  seed(2463534242u)
+{}
+
+savintsev::Project::Body::Body(const Body & other):
+  Body()
+{
+  std::vector< Node * > nodes;
+  nodes.reserve(size_of(other.root));
+  for (Node * node = leftmost(other.root); node; node = next_node(node))
+  {
+    nodes.push_back(acquire_node(node->layer, node->applied));
+    index_node(nodes.back());
+  }
+  root = build(nodes);
+}
+
+savintsev::Project::Node * savintsev::Project::Body::acquire_node(const Layer & layer, point_t applied)
+{
+  if (!free_list)
+  {
+    chunks.emplace_back(new Node[next_chunk_size]);
+    Node * chunk = chunks.back().get();
+    for (size_t i = 0; i + 1 < next_chunk_size; ++i)
+    {
+      chunk[i].right = chunk + i + 1;
+    }
+    chunk[next_chunk_size - 1].right = nullptr;
+    free_list = chunk;
+    next_chunk_size *= 2;
+  }
+  Node * node = free_list;
+  free_list = node->right;
+  node->layer = layer;
+  node->applied = applied;
+  node->parent = nullptr;
+  node->left = nullptr;
+  node->right = nullptr;
+  node->size = 1;
+  node->priority = next_priority();
+  return node;
+}
+
+void savintsev::Project::Body::release_node(Node * node) noexcept
+{
+  node->layer = Layer();
+  node->right = free_list;
+  free_list = node;
+}
+
+unsigned savintsev::Project::Body::next_priority() noexcept
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+void savintsev::Project::Body::index_node(Node * node)
+{
+  if (node->layer.second)
+  {
+    index.emplace(node->layer.second->get_name(), node);
+  }
+}
+
+void savintsev::Project::Body::unindex_node(Node * node)
+{
+  if (!node->layer.second)
+  {
+    return;
+  }
+  auto range = index.equal_range(node->layer.second->get_name());
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second == node)
+    {
+      index.erase(it);
+      return;
+    }
+  }
+}
+
+savintsev::Project::Project():
+  body_(std::make_shared< Body >()),
+  offset_{0.0, 0.0}
+{}
+
+savintsev::Project::iterator savintsev::Project::begin()
+{
+  unshare();
+  return iterator(this, leftmost(body_->root));
+}
+
+savintsev::Project::iterator savintsev::Project::end()
+{
+  unshare();
+  return iterator(this, nullptr);
+}
+
+savintsev::Project::const_iterator savintsev::Project::begin() const noexcept
+{
+  return const_iterator(this, leftmost(body_->root));
+}
+
+savintsev::Project::const_iterator savintsev::Project::end() const noexcept
+{
+  return const_iterator(this, nullptr);
+}
+
+savintsev::Project::reverse_iterator savintsev::Project::rbegin()
+{
+  return reverse_iterator(end());
+}
+
+savintsev::Project::reverse_iterator savintsev::Project::rend()
+{
+  return reverse_iterator(begin());
+}
+
+savintsev::Project::const_reverse_iterator savintsev::Project::rbegin() const noexcept
+{
+  return const_reverse_iterator(end());
+}
+
+savintsev::Project::const_reverse_iterator savintsev::Project::rend() const noexcept
+{
+  return const_reverse_iterator(begin());
+}
+
+size_t savintsev::Project::size() const noexcept
+{
+  return size_of(body_->root);
+}
+
+bool savintsev::Project::empty() const noexcept
+{
+  return body_->root == nullptr;
+}
+
+void savintsev::Project::push_back(const Layer & layer)
+{
+  insert(end(), layer);
+}
+
+savintsev::Project::iterator savintsev::Project::insert(const_iterator pos, const Layer & layer)
+{
+  unshare();
+  size_t at = pos.node_ ? position(pos) : size();
+  Node * node = body_->acquire_node(layer, offset_);
+  body_->index_node(node);
+  insert_node(node, at);
+  return iterator(this, node);
+}
+
+savintsev::Project::iterator savintsev::Project::erase(const_iterator pos)
+{
+  Node * node = unshare(pos);
+  Node * next = next_node(node);
+  extract_node(position(const_iterator(this, node)));
+  body_->unindex_node(node);
+  body_->release_node(node);
+  return iterator(this, next);
+}
+
+void savintsev::Project::clear()
+{
+  body_ = std::make_shared< Body >();
+}
+
+void savintsev::Project::reverse()
+{
+  unshare();
+  std::vector< Node * > nodes;
+  nodes.reserve(size());
+  for (Node * node = leftmost(body_->root); node; node = next_node(node))
+  {
+    nodes.push_back(node);
+  }
+  std::reverse(nodes.begin(), nodes.end());
+  body_->root = build(nodes);
+}
+
+void savintsev::Project::swap(Project & other) noexcept
+{
+  std::swap(body_, other.body_);
+  std::swap(offset_, other.offset_);
+}
+
+savintsev::Project::iterator savintsev::Project::find(const std::string & name)
+{
+  unshare();
+  const_iterator found = static_cast< const Project & >(*this).find(name);
+  return iterator(this, found.node_);
+}
+
+savintsev::Project::const_iterator savintsev::Project::find(const std::string & name) const
+{
+  auto range = body_->index.equal_range(name);
+  Node * lowest = nullptr;
+  size_t lowest_pos = size();
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    size_t pos = position(const_iterator(this, it->second));
+    if (pos < lowest_pos)
+    {
+      lowest = it->second;
+      lowest_pos = pos;
+    }
+  }
+  return const_iterator(this, lowest);
+}
+
+size_t savintsev::Project::position(const_iterator pos) const
+{
+  Node * node = pos.node_;
+  if (!node)
+  {
+    return size();
+  }
+  size_t result = size_of(node->left);
+  for (; node->parent; node = node->parent)
+  {
+    if (node == node->parent->right)
+    {
+      result += size_of(node->parent->left) + 1;
+    }
+  }
+  return result;
+}
+
+savintsev::Project::iterator savintsev::Project::at_position(size_t pos)
+{
+  unshare();
+  return iterator(this, node_at(pos));
+}
+
+void savintsev::Project::move_to(const_iterator pos, size_t new_pos)
+{
+  unshare();
+  Node * node = extract_node(position(pos));
+  insert_node(node, std::min(new_pos, size()));
+}
+
+void savintsev::Project::swap_layers(const_iterator lhs, const_iterator rhs)
+{
+  if (lhs == rhs)
+  {
+    unshare();
+    return;
+  }
+  Node * left = unshare(lhs);
+  Node * right = unshare(rhs);
+  body_->unindex_node(left);
+  body_->unindex_node(right);
+  std::swap(left->layer, right->layer);
+  std::swap(left->applied, right->applied);
+  body_->index_node(left);
+  body_->index_node(right);
+}
+
+void savintsev::Project::rename(const_iterator pos, const std::string & name)
+{
+  Node * node = unshare(pos);
+  Shape * target = own_shape(node);
+  body_->unindex_node(node);
+  target->set_name(name);
+  body_->index_node(node);
+}
+
+void savintsev::Project::move_all(double dx, double dy) noexcept
+{
+  offset_.x += dx;
+  offset_.y += dy;
+}
+
+savintsev::point_t savintsev::Project::shift(const_iterator pos) const noexcept
+{
+  return {offset_.x - pos.node_->applied.x, offset_.y - pos.node_->applied.y};
+}
+
+savintsev::Shape * savintsev::Project::shape(const_iterator pos)
+{
+  return own_shape(unshare(pos));
+}
+
+savintsev::Shape * savintsev::Project::own_shape(Node * node)
+{
+  if (node->layer.second.use_count() > 1)
+  {
+    node->layer.second.reset(node->layer.second->clone());
+  }
+  fold_node(node);
+  return node->layer.second.get();
+}
+
+void savintsev::Project::settle()
+{
+  unshare();
+  for (Node * node = leftmost(body_->root); node; node = next_node(node))
+  {
+    point_t delta = shift(const_iterator(this, node));
+    if (delta.x != 0.0 || delta.y != 0.0)
+    {
+      own_shape(node);
+    }
+  }
+}
+
+void savintsev::Project::append(const Project & other)
+{
+  if (empty())
+  {
+    body_ = other.body_;
+    offset_ = other.offset_;
+    return;
+  }
+  unshare();
+  size_t count = other.size();
+  const_iterator it = other.begin();
+  for (size_t i = 0; i < count; ++i, ++it)
+  {
+    point_t delta = other.shift(it);
+    Node * node = body_->acquire_node(*it, {offset_.x - delta.x, offset_.y - delta.y});
+    body_->index_node(node);
+    insert_node(node, size());
+  }
+}
+
+void savintsev::Project::unshare()
+{
+  if (body_.use_count() > 1)
+  {
+    body_ = std::make_shared< Body >(*body_);
+  }
+}
+
+savintsev::Project::Node * savintsev::Project::unshare(const_iterator pos)
+{
+  size_t at = position(pos);
+  unshare();
+  return node_at(at);
+}
+
+void savintsev::Project::fold_node(Node * node)
+{
+  point_t delta = shift(const_iterator(this, node));
+  if (delta.x != 0.0 || delta.y != 0.0)
+  {
+    node->layer.second->move(delta.x, delta.y);
+  }
+  node->applied = offset_;
+}
+
+size_t savintsev::Project::size_of(const Node * node) noexcept
+{
+  return node ? node->size : 0;
+}
+
+void savintsev::Project::update(Node * node) noexcept
+{
+  node->size = size_of(node->left) + size_of(node->right) + 1;
+  if (node->left)
+  {
+    node->left->parent = node;
+  }
+  if (node->right)
+  {
+    node->right->parent = node;
+  }
+}
+
+savintsev::Project::Node * savintsev::Project::merge(Node * lhs, Node * rhs) noexcept
+{
+  if (!lhs || !rhs)
+  {
+    return lhs ? lhs : rhs;
+  }
+  if (lhs->priority > rhs->priority)
+  {
+    lhs->right = merge(lhs->right, rhs);
+    update(lhs);
+    return lhs;
+  }
+  rhs->left = merge(lhs, rhs->left);
+  update(rhs);
+  return rhs;
+}
+
+void savintsev::Project::split(Node * node, size_t count, Node *& lhs, Node *& rhs) noexcept
+{
+  if (!node)
+  {
+    lhs = nullptr;
+    rhs = nullptr;
+    return;
+  }
+  if (size_of(node->left) < count)
+  {
+    split(node->right, count - size_of(node->left) - 1, node->right, rhs);
+    lhs = node;
+  }
+  else
+  {
+    split(node->left, count, lhs, node->left);
+    rhs = node;
+  }
+  update(node);
+}
+
+savintsev::Project::Node * savintsev::Project::build(const std::vector< Node * > & nodes)
+{
+  std::vector< Node * > spine;
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    Node * node = nodes[i];
+    Node * last = nullptr;
+    while (!spine.empty() && spine.back()->priority < node->priority)
+    {
+      last = spine.back();
+      spine.pop_back();
+    }
+    node->left = last;
+    node->right = nullptr;
+    if (!spine.empty())
+    {
+      spine.back()->right = node;
+    }
+    spine.push_back(node);
+  }
+  if (spine.empty())
+  {
+    return nullptr;
+  }
+  spine.front()->parent = nullptr;
+  refresh(spine.front());
+  return spine.front();
+}
+
+void savintsev::Project::refresh(Node * node) noexcept
+{
+  if (!node)
+  {
+    return;
+  }
+  refresh(node->left);
+  refresh(node->right);
+  update(node);
+}
+
+savintsev::Project::Node * savintsev::Project::leftmost(Node * node) noexcept
+{
+  while (node && node->left)
+  {
+    node = node->left;
+  }
+  return node;
+}
+
+savintsev::Project::Node * savintsev::Project::rightmost(Node * node) noexcept
+{
+  while (node && node->right)
+  {
+    node = node->right;
+  }
+  return node;
+}
+
+savintsev::Project::Node * savintsev::Project::next_node(Node * node) noexcept
+{
+  if (node->right)
+  {
+    return leftmost(node->right);
+  }
+  while (node->parent && node == node->parent->right)
+  {
+    node = node->parent;
+  }
+  return node->parent;
+}
+
+savintsev::Project::Node * savintsev::Project::prev_node(Node * node) const noexcept
+{
+  if (!node)
+  {
+    return rightmost(body_->root);
+  }
+  if (node->left)
+  {
+    return rightmost(node->left);
+  }
+  while (node->parent && node == node->parent->left)
+  {
+    node = node->parent;
+  }
+  return node->parent;
+}
+
+savintsev::Project::Node * savintsev::Project::node_at(size_t pos) const noexcept
+{
+  Node * node = body_->root;
+  while (node)
+  {
+    size_t left = size_of(node->left);
+    if (pos == left)
+    {
+      return node;
+    }
+    if (pos < left)
+    {
+      node = node->left;
+    }
+    else
+    {
+      pos -= left + 1;
+      node = node->right;
+    }
+  }
+  return nullptr;
+}
+
+void savintsev::Project::insert_node(Node * node, size_t pos) noexcept
+{
+  Node *& root = body_->root;
+  if (pos == size())
+  {
+    root = merge(root, node);
+    root->parent = nullptr;
+    return;
+  }
+  Node * lhs = nullptr;
+  Node * rhs = nullptr;
+  split(root, pos, lhs, rhs);
+  root = merge(merge(lhs, node), rhs);
+  root->parent = nullptr;
+}
+
+savintsev::Project::Node * savintsev::Project::extract_node(size_t pos) noexcept
+{
+  Node *& root = body_->root;
+  Node * lhs = nullptr;
+  Node * mid = nullptr;
+  Node * rhs = nullptr;
+  split(root, pos, lhs, rhs);
+  split(rhs, 1, mid, rhs);
+  root = merge(lhs, rhs);
+  if (root)
+  {
+    root->parent = nullptr;
+  }
+  mid->parent = nullptr;
+  return mid;
+}
@@ -1,14 +1,193 @@
 #ifndef PROJECT_BODY_HPP
 #define PROJECT_BODY_HPP
 #include <map>
-#include <list>
+#include <memory>
+#include <iterator>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 #include <shape.hpp>
 
 namespace savintsev
 {
-  using Layer = std::pair< std::string, Shape * >;
-  using Project = std::list< Layer >;
+  using Layer = std::pair< std::string, std::shared_ptr< Shape > >;
+
+  class Project
+  {
+    struct Node
+    {
+      Layer layer;
+      point_t applied;
+      Node * parent;
+      Node * left;
+      Node * right;
+      size_t size;
+      unsigned priority;
+    };
+  public:
+    template< class Value >
+    class basic_iterator
+    {
+    public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type = Layer;
+      using difference_type = std::ptrdiff_t;
+      using pointer = Value *;
+      using reference = Value &;
+
+      basic_iterator():
+        owner_(nullptr),
+        node_(nullptr)
+      {}
+      template< class Other, class = typename std::enable_if< std::is_same< Other, Layer >::value >::type >
+      basic_iterator(const basic_iterator< Other > & other):
+        owner_(other.owner_),
+        node_(other.node_)
+      {}
+
+      reference operator*() const
+      {
+        return node_->layer;
+      }
+      pointer operator->() const
+      {
+        return std::addressof(node_->layer);
+      }
+      basic_iterator & operator++()
+      {
+        node_ = Project::next_node(node_);
+        return *this;
+      }
+      basic_iterator operator++(int)
+      {
+        basic_iterator result(*this);
+        ++(*this);
+        return result;
+      }
+      basic_iterator & operator--()
+      {
+        node_ = owner_->prev_node(node_);
+        return *this;
+      }
+      basic_iterator operator--(int)
+      {
+        basic_iterator result(*this);
+        --(*this);
+        return result;
+      }
+      bool operator==(const basic_iterator & rhs) const
+      {
+        return node_ == rhs.node_;
+      }
+      bool operator!=(const basic_iterator & rhs) const
+      {
+        return node_ != rhs.node_;
+      }
+    private:
+      friend class Project;
+      template< class > friend class basic_iterator;
+
+      const Project * owner_;
+      Node * node_;
+
+      basic_iterator(const Project * owner, Node * node):
+        owner_(owner),
+        node_(node)
+      {}
+    };
+
+    using value_type = Layer;
+    using size_type = size_t;
+    using reference = Layer &;
+    using const_reference = const Layer &;
+    using iterator = basic_iterator< Layer >;
+    using const_iterator = basic_iterator< const Layer >;
+    using reverse_iterator = std::reverse_iterator< iterator >;
+    using const_reverse_iterator = std::reverse_iterator< const_iterator >;
+
+    Project();
+    Project(const Project & other) = default;
+    Project & operator=(const Project & other) = default;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator rend() const noexcept;
+
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    void push_back(const Layer & layer);
+    iterator insert(const_iterator pos, const Layer & layer);
+    iterator erase(const_iterator pos);
+    void clear();
+    void reverse();
+    void swap(Project & other) noexcept;
+
+    iterator find(const std::string & name);
+    const_iterator find(const std::string & name) const;
+    size_t position(const_iterator pos) const;
+    iterator at_position(size_t pos);
+    void move_to(const_iterator pos, size_t new_pos);
+    void swap_layers(const_iterator lhs, const_iterator rhs);
+    void rename(const_iterator pos, const std::string & name);
+
+    void move_all(double dx, double dy) noexcept;
+    point_t shift(const_iterator pos) const noexcept;
+    Shape * shape(const_iterator pos);
+    void settle();
+    void append(const Project & other);
+  private:
+    struct Body
+    {
+      static constexpr size_t first_chunk_size = 16;
+
+      std::vector< std::unique_ptr< Node[] > > chunks;
+      size_t next_chunk_size;
+      Node * free_list;
+      Node * root;
+      unsigned seed;
+      std::unordered_multimap< std::string, Node * > index;
+
+      Body();
+      Body(const Body & other);
+      Body & operator=(const Body &) = delete;
+
+      Node * acquire_node(const Layer & layer, point_t applied);
+      void release_node(Node * node) noexcept;
+      unsigned next_priority() noexcept;
+      void index_node(Node * node);
+      void unindex_node(Node * node);
+    };
+
+    std::shared_ptr< Body > body_;
+    point_t offset_;
+
+    void unshare();
+    Node * unshare(const_iterator pos);
+    Shape * own_shape(Node * node);
+    void fold_node(Node * node);
+
+    static size_t size_of(const Node * node) noexcept;
+    static void update(Node * node) noexcept;
+    static Node * merge(Node * lhs, Node * rhs) noexcept;
+    static void split(Node * node, size_t count, Node *& lhs, Node *& rhs) noexcept;
+    static Node * build(const std::vector< Node * > & nodes);
+    static void refresh(Node * node) noexcept;
+    static Node * leftmost(Node * node) noexcept;
+    static Node * rightmost(Node * node) noexcept;
+    static Node * next_node(Node * node) noexcept;
+    Node * prev_node(Node * node) const noexcept;
+    Node * node_at(size_t pos) const noexcept;
+    void insert_node(Node * node, size_t pos) noexcept;
+    Node * extract_node(size_t pos) noexcept;
+  };
+
   using Projects = std::map< std::string, Project >;
 }
 
@@ -2,6 +2,7 @@
 #include <fstream>
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
 #include <shape-utils.hpp>
 #include "renderer.hpp"
 #include "file-system.hpp"
@@ -63,17 +64,6 @@ namespace
       savintsev::write_savi_file(entry.first, entry.second);
     }
   };
-  struct ShapeNameEquals
-  {
-    const std::string & name;
-    ShapeNameEquals(const std::string & n):
-      name(n)
-    {}
-    bool operator()(const savintsev::Layer & layer) const
-    {
-      return layer.second && layer.second->get_name() == name;
-    }
-  };
   std::string make_sh(std::istream & in, savintsev::Projects & projs, std::string shape_name)
   {
     std::string proj;
@@ -84,39 +74,9 @@ namespace
     {
       throw std::runtime_error("Incorrect description of the shape");
     }
-    projs[proj].push_back({shape_name, shape});
+    projs[proj].push_back({shape_name, std::shared_ptr< savintsev::Shape >(shape)});
     return proj;
   }
-  struct CloneLayer
-  {
-    CloneLayer() = default;
-
-    savintsev::Layer operator()(const savintsev::Layer & layer) const
-    {
-      return {layer.first, layer.second->clone()};
-    }
-  };
-  struct MoveLayer
-  {
-    MoveLayer(double dx, double dy):
-      dx_(dx),
-      dy_(dy)
-    {}
-    void operator()(savintsev::Layer & layer) const
-    {
-      layer.second->move(dx_, dy_);
-    }
-  private:
-    double dx_;
-    double dy_;
-  };
-  struct Deleter
-  {
-    void operator()(savintsev::Layer & layer) const
-    {
-      delete layer.second;
-    }
-  };
 }
 
 void savintsev::save_all(std::ostream & out, Projects & projs)
@@ -134,8 +94,8 @@ void savintsev::merge(std::istream & in, std::ostream & out, Projects & projs)
   const Project & first = projs.at(src1);
   const Project & second = projs.at(src2);
 
-  std::transform(first.begin(), first.end(), std::back_inserter(target), CloneLayer());
-  std::transform(second.begin(), second.end(), std::back_inserter(target), CloneLayer());
+  target.append(first);
+  target.append(second);
 
   out << "Project \"" << src1 << "\" has been successfully merged with project \"" << src2 << "\"\n";
 }
@@ -163,10 +123,9 @@ void savintsev::delete_shape(std::istream & in, std::ostream & out, Projects & p
   std::string proj, shape_name;
   in >> proj >> shape_name;
   Project & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(shape_name));
+  auto it = pr.find(shape_name);
   if (it != pr.end())
   {
-    delete it->second;
     pr.erase(it);
     out << "\"" << shape_name << "\" was successfully removed from \"" << proj << "\"\n";
     return;
@@ -183,21 +142,21 @@ void savintsev::copy_proj_or_shape(std::istream & in, std::ostream & out, Projec
   {
     Project & source = projs.at(proj);
     Project & target = projs[second];
-    std::transform(source.begin(), source.end(), std::back_inserter(target), CloneLayer());
+    target.append(source);
     out << "Project \"" << proj << "\" was successfully copied to \"" << second << "\"\n";
   }
   else
   {
     Project & pr = projs.at(proj);
-    auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(second));
+    auto it = pr.find(second);
     if (it == pr.end())
     {
       out << "\"" << second << "\" not found in project \"" << proj << "\"\n";
       return;
     }
-    Shape * cloned = it->second->clone();
+    std::shared_ptr< Shape > cloned(pr.shape(it)->clone());
     cloned->set_name(third);
-    pr.insert(std::next(it), std::make_pair(it->first, cloned));
+    pr.insert(std::next(it), {it->first, cloned});
     out << "\"" << second << "\" was copied as \"" << third << "\" in project \"" << proj << "\"\n";
   }
 }
@@ -210,16 +169,16 @@ void savintsev::insert_shape(std::istream & in, std::ostream & out, Projects & p
   Project & from = projs.at(src_proj);
   Project & to = projs.at(dest_proj);
 
-  auto it = std::find_if(from.begin(), from.end(), ShapeNameEquals(shape_name));
+  auto it = from.find(shape_name);
   if (it == from.end())
   {
     out << "\"" << shape_name << "\" not found in project \"" << src_proj << "\"\n";
     return;
   }
 
-  Shape * cloned = it->second->clone();
-  to.push_back(std::make_pair(it->first, cloned));
+  std::shared_ptr< Shape > cloned(from.shape(it)->clone());
   cloned->set_name(shape_name + "_copy");
+  to.push_back({it->first, cloned});
 
   out << "\"" << shape_name << "\" from \"" << src_proj << "\" was inserted into \"" << dest_proj << "\"\n";
 }
@@ -242,7 +201,7 @@ void savintsev::rename_proj_or_shape(std::istream & in, std::ostream & out, Proj
     const std::string & new_name = third;
 
     Project & pr = projs.at(proj);
-    auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(old_name));
+    auto it = pr.find(old_name);
 
     if (it == pr.end())
     {
@@ -250,7 +209,7 @@ void savintsev::rename_proj_or_shape(std::istream & in, std::ostream & out, Proj
       return;
     }
 
-    it->second->set_name(new_name);
+    pr.rename(it, new_name);
     out << "\"" << old_name << "\" was renamed to \"" << new_name << "\" in project \"" << proj << "\"\n";
   }
 }
@@ -262,7 +221,7 @@ void savintsev::sf(std::istream & in, std::ostream & out, Projects & projs)
   in >> proj >> name >> n;
 
   Project & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
 
   if (it == pr.end())
   {
@@ -270,27 +229,9 @@ void savintsev::sf(std::istream & in, std::ostream & out, Projects & projs)
     return;
   }
 
-  Layer layer = *it;
-  it = pr.erase(it);
-
-  if (n > 0)
-  {
-    auto dest = it;
-    while (n-- > 0 && dest != pr.end())
-    {
-      ++dest;
-    }
-    pr.insert(dest, std::move(layer));
-  }
-  else
-  {
-    auto dest = it;
-    while (n++ < 0 && dest != pr.begin())
-    {
-      --dest;
-    }
-    pr.insert(dest, std::move(layer));
-  }
+  long long dest = static_cast< long long >(pr.position(it)) + n;
+  dest = std::max(0LL, std::min(dest, static_cast< long long >(pr.size() - 1)));
+  pr.move_to(it, static_cast< size_t >(dest));
 
   out << "\"" << name << "\" was moved in project \"" << proj << "\"\n";
 }
@@ -301,14 +242,14 @@ void savintsev::sf_above(std::istream & in, std::ostream & out, Projects & projs
   in >> proj >> name;
 
   Project & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
     return;
   }
 
-  pr.splice(pr.end(), pr, it);
+  pr.move_to(it, pr.size() - 1);
   out << "\"" << name << "\" was moved to the top in project \"" << proj << "\"\n";
 }
 
@@ -318,14 +259,14 @@ void savintsev::sf_below(std::istream & in, std::ostream & out, Projects & projs
   in >> proj >> name;
 
   Project & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
     return;
   }
 
-  pr.splice(pr.begin(), pr, it);
+  pr.move_to(it, 0);
   out << "\"" << name << "\" was moved to the bottom in project \"" << proj << "\"\n";
 }
 
@@ -336,8 +277,8 @@ void savintsev::swap_shapes(std::istream & in, std::ostream & out, Projects & pr
 
   Project & pr = projs.at(proj);
 
-  auto it1 = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name1));
-  auto it2 = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name2));
+  auto it1 = pr.find(name1);
+  auto it2 = pr.find(name2);
 
   if (it1 == pr.end() || it2 == pr.end())
   {
@@ -351,7 +292,7 @@ void savintsev::swap_shapes(std::istream & in, std::ostream & out, Projects & pr
     return;
   }
 
-  std::iter_swap(it1, it2);
+  pr.swap_layers(it1, it2);
   out << "\"" << name1 << "\" and \"" << name2 << "\" were swapped in \"" << proj << "\"\n";
 }
 
@@ -361,13 +302,13 @@ void savintsev::move_abs(std::istream & in, std::ostream & out, Projects & projs
   double x, y;
   in >> proj >> name >> x >> y;
   auto & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
     return;
   }
-  it->second->move({x, y});
+  pr.shape(it)->move({x, y});
   out << "\"" << name << "\" was succesfully moved\n";
 }
 
@@ -377,13 +318,13 @@ void savintsev::move_rel(std::istream & in, std::ostream & out, Projects & projs
   double dx, dy;
   in >> proj >> name >> dx >> dy;
   auto & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
     return;
   }
-  it->second->move(dx, dy);
+  pr.shape(it)->move(dx, dy);
   out << "\"" << name << "\" was succesfully moved\n";
 }
 
@@ -393,7 +334,7 @@ void savintsev::move_all(std::istream & in, std::ostream & out, Projects & projs
   double dx, dy;
   in >> proj >> dx >> dy;
   auto & pr = projs.at(proj);
-  std::for_each(pr.begin(), pr.end(), MoveLayer(dx, dy));
+  pr.move_all(dx, dy);
   out << "All shapes moved by (" << dx << ", " << dy << ")\n";
 }
 
@@ -403,13 +344,13 @@ void savintsev::scale_shape(std::istream & in, std::ostream & out, Projects & pr
   double k;
   in >> proj >> name >> k;
   auto & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
     return;
   }
-  it->second->scale(k);
+  pr.shape(it)->scale(k);
   out << "\"" << name << "\" was succesfully scaled\n";
 }
 
@@ -422,7 +363,7 @@ void savintsev::array_shapes(std::istream & in, std::ostream & out, Projects & p
   in >> proj >> name >> n >> dx >> dy;
 
   auto & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "\"" << name << "\" not found in project \"" << proj << "\"\n";
@@ -431,11 +372,11 @@ void savintsev::array_shapes(std::istream & in, std::ostream & out, Projects & p
 
   auto pos = std::next(it);
   const std::string type = it->first;
-  const Shape* base = it->second;
+  const Shape* base = pr.shape(it);
 
   for (int i = 1; i <= n; ++i)
   {
-    Shape* clone = base->clone();
+    std::shared_ptr< Shape > clone(base->clone());
     clone->set_name(name + "_" + std::to_string(i));
     clone->move(dx * i, dy * i);
     pos = pr.insert(pos, {type, clone});
@@ -463,7 +404,6 @@ void savintsev::clear_project(std::istream & in, std::ostream & out, Projects &
   ConfirmationPrompt prompt(in, out);
   if (prompt.ask("Are you sure you want to clear the project?"))
   {
-    std::for_each(pr.begin(), pr.end(), Deleter());
     pr.clear();
     out << "Project \"" << proj << "\" was successfully cleared\n";
     return;
@@ -548,10 +488,8 @@ void savintsev::print_shapes(std::istream & in, std::ostream & out, Projects & p
   shape_type["complexquad"] = "Cxquad";
   shape_type["concave"] = "Concav";
 
-  Project & pr = projs.at(proj);
-  pr.reverse();
-  std::for_each(pr.begin(), pr.end(), PrintShapeIndexed(out, shape_type));
-  pr.reverse();
+  const Project & pr = projs.at(proj);
+  std::for_each(pr.rbegin(), pr.rend(), PrintShapeIndexed(out, shape_type));
 }
 
 void savintsev::print_info_about_shape(std::istream & in, std::ostream & out, Projects  & projs)
@@ -559,8 +497,8 @@ void savintsev::print_info_about_shape(std::istream & in, std::ostream & out, Pr
   std::string proj, name;
   in >> proj >> name;
 
-  Project & pr = projs.at(proj);
-  auto it = std::find_if(pr.begin(), pr.end(), ShapeNameEquals(name));
+  const Project & pr = projs.at(proj);
+  auto it = pr.find(name);
   if (it == pr.end())
   {
     out << "Figure \"" << name << "\" not found in project \"" << proj << "\"\n";
@@ -570,7 +508,8 @@ void savintsev::print_info_about_shape(std::istream & in, std::ostream & out, Pr
   out << "Type " << it->first << '\n';
   out << "Name " << it->second->get_name() << '\n';
   const rectangle_t & frame = it->second->get_frame_rect();
-  out << "Cent (x: " << frame.pos.x << ", y: " << frame.pos.y << ")\n";
+  const point_t shift = pr.shift(it);
+  out << "Cent (x: " << frame.pos.x + shift.x << ", y: " << frame.pos.y + shift.y << ")\n";
   out << "Size (W: " << frame.width << ", H: " << frame.height << ")\n";
 }
 
@@ -587,6 +526,7 @@ void savintsev::render(std::istream & in, std::ostream & out, Projects & projs)
   }
 
   auto & proj = projs.at(proj_name);
+  proj.settle();
 
   Renderer rend;
   rend.render_project(proj, image_name, width, height);
@@ -3,6 +3,10 @@
 #include <random>
 #include <algorithm>
 #include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+#include <cmath>
 #include <boost/gil.hpp>
 #include <boost/gil/extension/io/bmp.hpp>
 #include <shape-utils.hpp>
@@ -15,64 +19,108 @@ namespace savintsev
   class Renderer
   {
   public:
+    Renderer():
+      rng_(std::random_device{}()),
+      dist_(50, 240)
+    {}
     void render_project(const savintsev::Project & proj, const std::string & name, int w, int h)
     {
       gil::rgb8_image_t image(w, h);
       auto view = gil::view(image);
 
       gil::fill_pixels(view, gil::rgb8_pixel_t(255, 255, 255));
-      struct RenderWrapper
+      struct PrepareWrapper
       {
-        RenderWrapper(Renderer * r, gil::rgb8_view_t & v):
+        PrepareWrapper(Renderer * r, std::vector< Polygon > & p):
           renderer(r),
-          view(v)
+          polygons(p)
         {}
         void operator()(const savintsev::Layer & layer)
         {
-          renderer->render_shape(view, layer.second);
+          polygons.push_back(renderer->prepare_shape(layer.second.get()));
         }
         Renderer * renderer;
-        gil::rgb8_view_t & view;
+        std::vector< Polygon > & polygons;
       };
 
-      std::for_each(proj.begin(), proj.end(), RenderWrapper(this, view));
+      std::vector< Polygon > polygons;
+      polygons.reserve(proj.size());
+      std::for_each(proj.begin(), proj.end(), PrepareWrapper(this, polygons));
+
+      int bands = std::max(1, std::min(static_cast< int >(std::thread::hardware_concurrency()), h / min_band_height));
+      int band_height = (h + bands - 1) / bands;
+      std::vector< std::future< void > > tasks;
+      for (int y = band_height; y < h; y += band_height)
+      {
+        tasks.push_back(std::async(std::launch::async, fill_band, view, std::cref(polygons), y, std::min(h, y + band_height)));
+      }
+      fill_band(view, polygons, 0, std::min(h, band_height));
+      std::for_each(tasks.begin(), tasks.end(), std::mem_fn(&std::future< void >::get));
 
       gil::write_view(name + ".bmp", view, gil::bmp_tag{});
     }
   private:
-    private:
-    void render_shape(gil::rgb8_view_t & view, const savintsev::Shape * shape)
+    static constexpr int min_band_height = 64;
+
+    struct Polygon
     {
-      std::mt19937 rng(std::random_device{}());
-      std::uniform_int_distribution<int> dist(50, 240);
+      savintsev::point_t points[4];
+      size_t count;
+      double min_y;
+      double max_y;
+      gil::rgb8_pixel_t color;
+    };
 
-      gil::rgb8_pixel_t color
+    std::mt19937 rng_;
+    std::uniform_int_distribution< int > dist_;
+
+    Polygon prepare_shape(const savintsev::Shape * shape)
+    {
+      Polygon poly;
+      poly.color = gil::rgb8_pixel_t
       (
-        static_cast< uint8_t >(dist(rng)),
-        static_cast< uint8_t >(dist(rng)),
-        static_cast< uint8_t >(dist(rng))
+        static_cast< uint8_t >(dist_(rng_)),
+        static_cast< uint8_t >(dist_(rng_)),
+        static_cast< uint8_t >(dist_(rng_))
       );
 
       savintsev::point_t points[4];
-      size_t point_count = shape->get_all_points(points);
+      poly.count = shape->get_all_points(points);
 
-      if (point_count == 2)
+      if (poly.count == 2)
       {
-        savintsev::point_t rect_points[4];
-        rect_points[0] = {points[0].x, points[0].y};
-        rect_points[1] = {points[1].x, points[0].y};
-        rect_points[2] = {points[1].x, points[1].y};
-        rect_points[3] = {points[0].x, points[1].y};
-        fill_shape(view, rect_points, 4, color);
+        poly.points[0] = {points[0].x, points[0].y};
+        poly.points[1] = {points[1].x, points[0].y};
+        poly.points[2] = {points[1].x, points[1].y};
+        poly.points[3] = {points[0].x, points[1].y};
+        poly.count = 4;
       }
       else
       {
-        fill_shape(view, points, point_count, color);
+        std::copy(points, points + poly.count, poly.points);
+      }
+
+      poly.min_y = poly.points[0].y;
+      poly.max_y = poly.points[0].y;
+      for (size_t i = 1; i < poly.count; ++i)
+      {
+        poly.min_y = std::min(poly.min_y, poly.points[i].y);
+        poly.max_y = std::max(poly.max_y, poly.points[i].y);
       }
+      return poly;
     }
-    void fill_shape(gil::rgb8_view_t & view, const savintsev::point_t * points, size_t count, gil::rgb8_pixel_t c)
+
+    static void fill_band(gil::rgb8_view_t view, const std::vector< Polygon > & polygons, int y_begin, int y_end)
     {
-      if (count < 3)
+      for (size_t i = 0; i < polygons.size(); ++i)
+      {
+        fill_shape(view, polygons[i], y_begin, y_end);
+      }
+    }
+
+    static void fill_shape(gil::rgb8_view_t & view, const Polygon & poly, int y_begin, int y_end)
+    {
+      if (poly.count < 3)
       {
         return;
       }
@@ -80,36 +128,78 @@ namespace savintsev
       int width = view.width();
       int height = view.height();
 
-      for (int y = 0; y < height; ++y)
+      int first_row = clamp_row(std::floor(height / 2.0 + 0.5 - poly.max_y), height);
+      int last_row = clamp_row(std::ceil(height / 2.0 + 0.5 - poly.min_y), height);
+      first_row = std::max(first_row, y_begin);
+      last_row = std::min(last_row, y_end - 1);
+
+      double crossings[4];
+      for (int y = first_row; y <= last_row; ++y)
       {
-        for (int x = 0; x < width; ++x)
+        double fy = height / 2.0 - y + 0.5;
+        size_t found = find_crossings(poly, fy, crossings);
+        std::sort(crossings, crossings + found);
+        auto row = view.row_begin(y);
+        for (size_t k = 0; k + 1 < found; k += 2)
         {
-          double fx = x - width / 2.0;
-          double fy = height / 2.0 - y;
-
-          if (is_point_in_polygon(points, count, fx + 0.5, fy + 0.5))
+          int x_begin = first_column_at_or_after(crossings[k], width);
+          int x_end = first_column_at_or_after(crossings[k + 1], width);
+          if (x_begin < x_end)
           {
-            view(x, y) = c;
+            std::fill(row + x_begin, row + x_end, poly.color);
           }
         }
       }
     }
 
-    bool is_point_in_polygon(const savintsev::point_t * points, size_t point_count, double x, double y)
+    static int clamp_row(double row, int height)
     {
-      bool inside = false;
-      for (size_t i = 0, j = point_count - 1; i < point_count; j = i++)
+      return static_cast< int >(std::min(std::max(0.0, row), static_cast< double >(height)));
+    }
+
+    static size_t find_crossings(const Polygon & poly, double y, double * crossings)
+    {
+      size_t found = 0;
+      for (size_t i = 0, j = poly.count - 1; i < poly.count; j = i++)
       {
-        double xi = points[i].x, yi = points[i].y;
-        double xj = points[j].x, yj = points[j].y;
+        double xi = poly.points[i].x, yi = poly.points[i].y;
+        double xj = poly.points[j].x, yj = poly.points[j].y;
 
-        bool intersect = ((yi > y) != (yj > y)) && (x < (xj - xi) * (y - yi) / (yj - yi + 1e-15) + xi);
-        if (intersect)
+        if ((yi > y) != (yj > y))
         {
-          inside = !inside;
+          crossings[found++] = (xj - xi) * (y - yi) / (yj - yi + 1e-15) + xi;
         }
       }
-      return inside;
+      return found;
+    }
+
+    static double sample_x(int x, int width)
+    {
+      double fx = x - width / 2.0;
+      return fx + 0.5;
+    }
+
+    static int first_column_at_or_after(double crossing, int width)
+    {
+      double guess = std::ceil(crossing + width / 2.0 - 0.5);
+      if (guess <= 0)
+      {
+        return 0;
+      }
+      if (guess >= width)
+      {
+        return width;
+      }
+      int x = static_cast< int >(guess);
+      while (x > 0 && sample_x(x - 1, width) >= crossing)
+      {
+        --x;
+      }
+      while (x < width && sample_x(x, width) < crossing)
+      {
+        ++x;
+      }
+      return x;
     }
   };
 }
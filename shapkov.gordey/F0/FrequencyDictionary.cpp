@@ -5,10 +5,25 @@
 #include <algorithm>
 #include <iterator>
 #include <numeric>
+#include <regex>
 #include <vector>
 #include <scopeGuard.hpp>
 #include "analyzeAndParseFunctors.hpp"
 
+std::string shapkov::anagramSignature(const std::string& word)
+{
+  std::string signature(word);
+  std::sort(signature.begin(), signature.end());
+  return signature;
+}
+
+void shapkov::buildAnagramIndex(OneFreqDict& text)
+{
+  text.anagrams.clear();
+  AnagramIndexer indexer{ text.anagrams };
+  std::for_each(text.dictionary.begin(), text.dictionary.end(), indexer);
+}
+
 void shapkov::analyzeText(std::istream& in, std::ostream& out, FrequencyDictionary& dict)
 {
   std::string fileName, id;
@@ -40,6 +55,7 @@ void shapkov::analyzeText(std::istream& in, std::ostream& out, FrequencyDictiona
     out << "<EMPTY TEXT>\n";
     return;
   }
+  buildAnagramIndex(temp);
   dict.dicts.emplace(std::move(id), std::move(temp));
 }
 
@@ -70,10 +86,10 @@ void shapkov::anagrams(std::istream& in, std::ostream& out, const FrequencyDicti
   std::string word;
   in >> word;
   cleanWord(word);
-  isAnagram anagramChecker{ word };
+  std::string signature = anagramSignature(word);
   size_t anagramsCnt = 0;
-  DictProcessor< isAnagram > dictProcessor{ out, anagramChecker, anagramsCnt };
-  std::for_each(dict.dicts.begin(), dict.dicts.end(), dictProcessor);
+  AnagramPrinter printer{ out, signature, anagramsCnt };
+  std::for_each(dict.dicts.begin(), dict.dicts.end(), printer);
   if (anagramsCnt == 0)
   {
     out << "<NO ANAGRAMS>\n";
@@ -172,7 +188,8 @@ void shapkov::palindromes(std::istream& in, std::ostream& out, const FrequencyDi
   }
   isPalindrome PalindromeChecker;
   std::vector< std::string > txtWords;
-  auto txt = text->second.dictionary;
+  const auto& txt = text->second.dictionary;
+  txtWords.reserve(txt.size());
   std::transform(txt.begin(), txt.end(), std::back_inserter(txtWords), ExtractFirst());
   std::copy_if(txtWords.begin(), txtWords.end(), std::ostream_iterator< std::string >{ out, "\n" }, std::ref(PalindromeChecker));
   if (PalindromeChecker.palindromesCnt == 0)
@@ -191,9 +208,11 @@ void shapkov::showWithPattern(std::istream& in, std::ostream& out, const Frequen
     out << "<TEXT NOT FOUND>\n";
     return;
   }
-  isPattern PatternChecker{ pattern };
+  std::regex compiled(pattern, std::regex::ECMAScript | std::regex::optimize);
+  isPattern PatternChecker{ compiled };
   std::vector< std::string > txtWords;
-  auto txt = text->second.dictionary;
+  const auto& txt = text->second.dictionary;
+  txtWords.reserve(txt.size());
   std::transform(txt.begin(), txt.end(), std::back_inserter(txtWords), ExtractFirst());
   std::copy_if(txtWords.begin(), txtWords.end(), std::ostream_iterator< std::string >{ out, "\n" }, std::ref(PatternChecker));
   if (PatternChecker.patternMatches == 0)
@@ -339,6 +358,7 @@ void shapkov::merge(std::istream& in, std::ostream& out, FrequencyDictionary& di
   OneFreqDict temp(text1->second);
   MergeFunctor merger{ temp.dictionary, temp.size };
   std::for_each(text2->second.dictionary.begin(), text2->second.dictionary.end(), merger);
+  buildAnagramIndex(temp);
   dict.dicts.emplace(std::move(newDictId), std::move(temp));
 }
 
@@ -368,6 +388,7 @@ void shapkov::diff(std::istream& in, std::ostream& out, FrequencyDictionary& dic
     out << "<NO DIFFERENCES>\n";
     return;
   }
+  buildAnagramIndex(temp);
   dict.dicts.emplace(std::move(newDictId), std::move(temp));
 }
 
@@ -402,6 +423,7 @@ void shapkov::intersect(std::istream& in, std::ostream& out, FrequencyDictionary
     out << "<NO INTERSECTIONS>\n";
     return;
   }
+  buildAnagramIndex(temp);
   dict.dicts.emplace(std::move(newDictId), std::move(temp));
 }
 
@@ -462,5 +484,9 @@ void shapkov::load(std::ostream& out, const std::string& fileName, FrequencyDict
       currentDict->dictionary[word] = count;
     }
   }
+  for (auto& pair: dict.dicts)
+  {
+    buildAnagramIndex(pair.second);
+  }
   out << "<LOADED SUCCESSFULLY>\n";
 }
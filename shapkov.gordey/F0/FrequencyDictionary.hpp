@@ -2,6 +2,7 @@
 #define FREQUENCY_DICTIONARY
 #include <unordered_map>
 #include <string>
+#include <vector>
 #include <iostream>
 
 namespace shapkov
@@ -9,12 +10,15 @@ namespace shapkov
   struct OneFreqDict
   {
     std::unordered_map< std::string, size_t > dictionary;
+    std::unordered_map< std::string, std::vector< std::string > > anagrams;
     size_t size = 0;
   };
   struct FrequencyDictionary
   {
     std::unordered_map< std::string, OneFreqDict > dicts;
   };
+  std::string anagramSignature(const std::string& word);
+  void buildAnagramIndex(OneFreqDict& text);
   void analyzeText(std::istream& in, std::ostream& out, FrequencyDictionary& dict);
   void wordInfo(std::istream& in, std::ostream& out, const FrequencyDictionary& dict);
   void anagrams(std::istream& in, std::ostream& out, const FrequencyDictionary& dict);
@@ -1,13 +1,45 @@
 #include "analyzeAndParseFunctors.hpp"
 #include <algorithm>
 #include <cctype>
-#include <regex>
 #include <cmath>
 
-bool shapkov::isAnagram::operator()(const std::pair< std::string, size_t >& wordPair) const
+namespace
 {
-  const std::string& word = wordPair.first;
-  return word.size() == wrd.size() && std::is_permutation(word.begin(), word.end(), wrd.begin());
+  struct isNonAlpha
+  {
+    bool operator()(char c) const
+    {
+      return !(std::isalpha(static_cast< unsigned char >(c)) || c == '`');
+    }
+  };
+
+  struct AnagramWordPrinter
+  {
+    std::ostream& out;
+    const std::string& dictName;
+    const std::unordered_map< std::string, size_t >& dictionary;
+    void operator()(const std::string& word) const
+    {
+      out << dictName << ": " << word << " - " << dictionary.find(word)->second << '\n';
+    }
+  };
+}
+
+void shapkov::AnagramIndexer::operator()(const std::pair< const std::string, size_t >& wordPair) const
+{
+  index[anagramSignature(wordPair.first)].push_back(wordPair.first);
+}
+
+void shapkov::AnagramPrinter::operator()(const std::pair< const std::string, OneFreqDict >& dictPair) const
+{
+  auto group = dictPair.second.anagrams.find(signature);
+  if (group == dictPair.second.anagrams.end())
+  {
+    return;
+  }
+  AnagramWordPrinter printer{ out, dictPair.first, dictPair.second.dictionary };
+  std::for_each(group->second.begin(), group->second.end(), printer);
+  counter += group->second.size();
 }
 
 bool shapkov::FrequencyChecker::operator()(const std::pair< std::string, size_t >& wordPair) const
@@ -27,8 +59,7 @@ bool shapkov::isPalindrome::operator()(const std::string& word)
 
 void shapkov::cleanWord(std::string& word)
 {
-  std::regex nonAlpha("[^a-zA-Z`]");
-  word = std::regex_replace(word, nonAlpha, "");
+  word.erase(std::remove_if(word.begin(), word.end(), isNonAlpha()), word.end());
   std::transform(word.begin(), word.end(), word.begin(), ::tolower);
 }
 
@@ -45,8 +76,7 @@ std::string shapkov::ExtractFirst::operator()(const std::pair< std::string, size
 
 bool shapkov::isPattern::operator()(const std::string& word)
 {
-  std::regex patt(pattern);
-  bool isPatt = std::regex_match(word, patt);
+  bool isPatt = std::regex_match(word, pattern);
   if (isPatt)
   {
     patternMatches++;
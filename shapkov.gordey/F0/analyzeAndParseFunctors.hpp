@@ -4,14 +4,22 @@
 #include <string>
 #include <algorithm>
 #include <iostream>
+#include <regex>
 #include "FrequencyDictionary.hpp"
 
 namespace shapkov
 {
-  struct isAnagram
+  struct AnagramIndexer
   {
-    std::string& wrd;
-    bool operator()(const std::pair< std::string, size_t >& wordPair) const;
+    std::unordered_map< std::string, std::vector< std::string > >& index;
+    void operator()(const std::pair< const std::string, size_t >& wordPair) const;
+  };
+  struct AnagramPrinter
+  {
+    std::ostream& out;
+    const std::string& signature;
+    size_t& counter;
+    void operator()(const std::pair< const std::string, OneFreqDict >& dictPair) const;
   };
   struct FrequencyChecker
   {
@@ -38,7 +46,7 @@ namespace shapkov
   };
   struct isPattern
   {
-    std::string& pattern;
+    const std::regex& pattern;
     size_t patternMatches = 0;
     bool operator()(const std::string& word);
   };
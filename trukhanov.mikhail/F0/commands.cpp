@@ -89,8 +89,9 @@ void trukhanov::CommandProcessor::createIndex(const std::string& indexName, cons
 
   std::vector< std::size_t > lineNumbers(newIndex.lines.size());
   std::iota(lineNumbers.begin(), lineNumbers.end(), 0);
+  newIndex.tokens.resize(newIndex.lines.size());
 
-  SplitWords processor{ newIndex.lines, newIndex.index };
+  SplitWords processor{ newIndex };
   std::transform(lineNumbers.begin(), lineNumbers.end(), lineNumbers.begin(), processor);
 
   indexes_[indexName] = std::move(newIndex);
@@ -203,9 +204,12 @@ void trukhanov::CommandProcessor::filterLines(const std::string& indexName, std:
     throw std::invalid_argument("Invalid command");
   }
 
-  ConcordanceIndex newIndex;
-  newIndex.lines.assign(it->second.lines.begin() + fromLine - 1, it->second.lines.begin() + toLine);
+  if (fromLine == 0 || fromLine > toLine || toLine > it->second.lines.size())
+  {
+    throw std::invalid_argument("Invalid command");
+  }
 
+  ConcordanceIndex newIndex;
   LineFilter filter{ it->second, newIndex, fromLine, toLine };
   filter();
 
@@ -352,6 +356,13 @@ void trukhanov::CommandProcessor::mergeIndexes(const std::string& index1, const
   std::copy(lines1.begin(), lines1.end(), std::back_inserter(result.lines));
   std::copy(lines2.begin(), lines2.end(), std::back_inserter(result.lines));
 
+  std::vector< LineTokens >& tokens1 = it1->second.tokens;
+  std::vector< LineTokens >& tokens2 = it2->second.tokens;
+
+  result.tokens.reserve(tokens1.size() + tokens2.size());
+  std::copy(tokens1.begin(), tokens1.end(), std::back_inserter(result.tokens));
+  std::copy(tokens2.begin(), tokens2.end(), std::back_inserter(result.tokens));
+
   indexes_[newIndex] = std::move(result);
   out_ << "Index " << newIndex << " created by merging" << '\n';
 }
@@ -394,11 +405,12 @@ void trukhanov::CommandProcessor::mergeByLines(const std::string& index1, const
 
   ConcordanceIndex resultIndex;
   resultIndex.lines = mergedLines;
+  resultIndex.tokens.resize(maxSize);
 
   std::vector< std::size_t > lineNumbers(maxSize);
   std::iota(lineNumbers.begin(), lineNumbers.end(), 1);
 
-  std::transform(lineNumbers.begin(), lineNumbers.end(), lineNumbers.begin(), SplitAndAdd{ resultIndex, resultIndex.lines });
+  std::transform(lineNumbers.begin(), lineNumbers.end(), lineNumbers.begin(), SplitAndAdd{ resultIndex });
 
   indexes_[newIndex] = std::move(resultIndex);
   out_ << "Index " << newIndex << " created by merging lines" << '\n';
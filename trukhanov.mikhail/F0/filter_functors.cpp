@@ -1,38 +1,7 @@
 #include "filter_functors.hpp"
+#include "split_functors.hpp"
 #include <algorithm>
-#include <iterator>
-
-bool trukhanov::InRange::operator()(std::size_t val) const
-{
-  return val >= from && val <= to;
-}
-
-std::size_t trukhanov::AdjustOffset::operator()(std::size_t val) const
-{
-  return val - offset;
-}
-
-std::pair< std::string, std::set< std::size_t > > trukhanov::FilterAdjustPair::operator()(
-  const std::pair< const std::string, std::set< std::size_t > >& pair) const
-{
-  std::vector< std::size_t > filtered;
-  std::copy_if(pair.second.begin(), pair.second.end(), std::back_inserter(filtered), InRange{ from, to });
-
-  if (filtered.empty())
-  {
-    return {};
-  }
-
-  std::set< std::size_t > adjusted;
-  std::transform(
-    filtered.begin(),
-    filtered.end(),
-    std::inserter(adjusted, adjusted.end()),
-    AdjustOffset{ from - 1 }
-  );
-
-  return { pair.first, std::move(adjusted) };
-}
+#include <numeric>
 
 trukhanov::LineFilter::LineFilter(const ConcordanceIndex& s, ConcordanceIndex& d, std::size_t f,std::size_t t):
   from(f), to(t), src(s), dest(d)
@@ -40,10 +9,10 @@ trukhanov::LineFilter::LineFilter(const ConcordanceIndex& s, ConcordanceIndex& d
 
 void trukhanov::LineFilter::operator()() const
 {
-  std::transform(
-    src.index.begin(),
-    src.index.end(),
-    std::inserter(dest.index, dest.index.end()),
-    FilterAdjustPair{ from, to }
-  );
+  dest.lines.assign(src.lines.begin() + from - 1, src.lines.begin() + to);
+  dest.tokens.assign(src.tokens.begin() + from - 1, src.tokens.begin() + to);
+
+  std::vector< std::size_t > lineNumbers(dest.lines.size());
+  std::iota(lineNumbers.begin(), lineNumbers.end(), 1);
+  std::for_each(lineNumbers.begin(), lineNumbers.end(), IndexTokens{ dest });
 }
@@ -20,10 +20,19 @@ namespace trukhanov
   std::ostream& operator<<(std::ostream& out, const std::set< size_t >& s);
   std::ostream& operator<<(std::ostream& out, const WordEntry& entry);
 
+  struct TokenPos
+  {
+    std::size_t offset;
+    std::size_t length;
+  };
+
+  using LineTokens = std::vector< TokenPos >;
+
   struct ConcordanceIndex
   {
     IndexMap index;
     std::vector< std::string > lines;
+    std::vector< LineTokens > tokens;
     std::string sourceFile;
   };
 
@@ -2,10 +2,16 @@
 #include <algorithm>
 #include <iterator>
 
-std::string trukhanov::LineSplitter::operator()(const std::string& word) const
+void trukhanov::TokenIndexer::operator()(const TokenPos& token) const
 {
-  wordMap[word].insert(lineNumber);
-  return word;
+  wordMap[line.substr(token.offset, token.length)].insert(lineNumber);
+}
+
+std::size_t trukhanov::IndexTokens::operator()(std::size_t lineNum) const
+{
+  const LineTokens& tokens = idx.tokens[lineNum - 1];
+  std::for_each(tokens.begin(), tokens.end(), TokenIndexer{ idx.index, idx.lines[lineNum - 1], lineNum });
+  return lineNum;
 }
 
 std::size_t trukhanov::countWords(const std::string& line)
@@ -15,15 +21,8 @@ std::size_t trukhanov::countWords(const std::string& line)
 
 std::size_t trukhanov::SplitWords::operator()(std::size_t lineNumber) const
 {
-  const std::string& line = lines.at(lineNumber);
-
-  std::vector< std::string > words;
-  std::size_t wordCount = countWords(line);
-  WordGenerator gen{ line.begin(), line.end() };
-  std::generate_n(std::back_inserter(words),wordCount, gen);
-
-  std::transform(words.begin(), words.end(), words.begin(), LineSplitter{ wordMap, lineNumber + 1 });
-
+  idx.tokens.at(lineNumber) = tokenizeLine(idx.lines.at(lineNumber));
+  IndexTokens{ idx }(lineNumber + 1);
   return lineNumber;
 }
 
@@ -62,15 +61,27 @@ std::string trukhanov::WordGenerator::operator()()
   return word;
 }
 
-std::size_t trukhanov::SplitAndAdd::operator()(std::size_t lineNum) const
+trukhanov::TokenPos trukhanov::TokenGenerator::operator()()
 {
-  const std::string& line = lines[lineNum - 1];
+  auto begin = std::find_if(line.begin() + pos, line.end(), notSpace);
+  auto end = std::find_if(begin, line.end(), isSpace);
+  TokenPos token{ static_cast< std::size_t >(begin - line.begin()), static_cast< std::size_t >(end - begin) };
+  pos = token.offset + token.length;
+  return token;
+}
 
-  std::vector< std::string > words;
+trukhanov::LineTokens trukhanov::tokenizeLine(const std::string& line)
+{
+  LineTokens tokens;
   std::size_t wordCount = countWords(line);
-  WordGenerator gen{ line.begin(), line.end() };
-  std::generate_n(std::back_inserter(words), wordCount, gen);
+  tokens.reserve(wordCount);
+  std::generate_n(std::back_inserter(tokens), wordCount, TokenGenerator{ line, 0 });
+  return tokens;
+}
 
-  std::transform(words.begin(), words.end(), words.begin(), LineSplitter{ idx.index, lineNum });
+std::size_t trukhanov::SplitAndAdd::operator()(std::size_t lineNum) const
+{
+  idx.tokens[lineNum - 1] = tokenizeLine(idx.lines[lineNum - 1]);
+  IndexTokens{ idx }(lineNum);
   return lineNum;
 }
@@ -2,23 +2,28 @@
 #define SPLIT_FUNCTORS_HPP
 
 #include <string>
-#include <map>
-#include <set>
+#include <vector>
 #include "index.hpp"
 
 namespace trukhanov
 {
-  struct LineSplitter
+  struct TokenIndexer
   {
     IndexMap& wordMap;
+    const std::string& line;
     std::size_t lineNumber;
-    std::string operator()(const std::string& word) const;
+    void operator()(const TokenPos& token) const;
+  };
+
+  struct IndexTokens
+  {
+    ConcordanceIndex& idx;
+    std::size_t operator()(std::size_t lineNum) const;
   };
 
   struct SplitWords
   {
-    std::vector< std::string >& lines;
-    IndexMap& wordMap;
+    ConcordanceIndex& idx;
     std::size_t operator()(std::size_t lineNumber) const;
   };
 
@@ -42,10 +47,18 @@ namespace trukhanov
     std::string operator()();
   };
 
+  struct TokenGenerator
+  {
+    const std::string& line;
+    std::size_t pos;
+    TokenPos operator()();
+  };
+
+  LineTokens tokenizeLine(const std::string& line);
+
   struct SplitAndAdd
   {
     ConcordanceIndex& idx;
-    std::vector< std::string >& lines;
     std::size_t operator()(std::size_t lineNum) const;
   };
 }
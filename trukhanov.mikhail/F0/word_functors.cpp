@@ -40,8 +40,43 @@ void trukhanov::ReplaceWordFunctor::operator()()
     return;
   }
 
-  index.index[newWord].insert(it->second.begin(), it->second.end());
-  index.index.erase(oldWord);
+  const std::set< std::size_t >& affected = it->second;
+  std::for_each(affected.begin(), affected.end(), RewriteLine{ index, oldWord, newWord });
+
+  index.index[newWord].insert(affected.begin(), affected.end());
+  index.index.erase(it);
+}
+
+void trukhanov::TokenRewriter::operator()(TokenPos& token)
+{
+  std::size_t oldOffset = token.offset;
+  rewritten.append(line, copied, oldOffset - copied);
+  copied = oldOffset + token.length;
+  token.offset = rewritten.size();
+
+  if (line.compare(oldOffset, token.length, oldWord) == 0)
+  {
+    rewritten += newWord;
+    token.length = newWord.size();
+  }
+  else
+  {
+    rewritten.append(line, oldOffset, token.length);
+  }
+}
+
+void trukhanov::RewriteLine::operator()(std::size_t lineNumber) const
+{
+  std::string& line = index.lines[lineNumber - 1];
+  LineTokens& tokens = index.tokens[lineNumber - 1];
+
+  std::string rewritten;
+  rewritten.reserve(line.size());
+  TokenRewriter rewriter{ line, oldWord, newWord, rewritten, 0 };
+  std::size_t copied = std::for_each(tokens.begin(), tokens.end(), rewriter).copied;
+  rewritten.append(line, copied, std::string::npos);
+
+  line = std::move(rewritten);
 }
 
 trukhanov::ExportWordFunctor::ExportWordFunctor(
@@ -26,6 +26,24 @@ namespace trukhanov
     void operator()();
   };
 
+  struct TokenRewriter
+  {
+    const std::string& line;
+    const std::string& oldWord;
+    const std::string& newWord;
+    std::string& rewritten;
+    std::size_t copied;
+    void operator()(TokenPos& token);
+  };
+
+  struct RewriteLine
+  {
+    ConcordanceIndex& index;
+    const std::string& oldWord;
+    const std::string& newWord;
+    void operator()(std::size_t lineNumber) const;
+  };
+
   struct ExportWordFunctor
   {
     ExportWordFunctor(const std::vector< std::string >& lines, std::ostream& out, const std::string& word);